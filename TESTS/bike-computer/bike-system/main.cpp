@@ -150,6 +150,9 @@ static void test_bike_system_with_event() {
 
 // test_multi_tasking_bike_system handler function
 static void test_multi_tasking_bike_system() {
+    // do not restore the state left by a previous test case
+    bike_computer::RetainedRideState::getInstance().invalidate();
+
     // create the BikeSystem instance
     multi_tasking::BikeSystem bikeSystem;
 
@@ -187,6 +190,9 @@ static void test_multi_tasking_bike_system() {
 }
 
 static void test_gear_multi_tasking_bike_system() {
+    // do not restore the state left by a previous test case
+    bike_computer::RetainedRideState::getInstance().invalidate();
+
     // create the BikeSystem instance
     multi_tasking::BikeSystem bikeSystem;
 
@@ -247,6 +253,57 @@ static void test_gear_multi_tasking_bike_system() {
     bikeSystem.stop();
 }
 
+// test_drivetrain_profile_multi_tasking_bike_system handler function
+static void test_drivetrain_profile_multi_tasking_bike_system() {
+    // do not restore the state left by a previous test case
+    bike_computer::RetainedRideState::getInstance().invalidate();
+
+    // 2 m wheel, one 40 teeth chainring and 5 cogs
+    const bike_computer::DrivetrainProfile profile = {
+        2.0f, 1, {40}, 5, {21, 19, 17, 15, 13}};
+    constexpr float kAllowedWheelDelta = 0.0001f;
+    {
+        multi_tasking::BikeSystem bikeSystem;
+        Thread thread;
+        thread.start(callback(&bikeSystem, &multi_tasking::BikeSystem::start));
+        ThisThread::sleep_for(2s);
+
+        // an invalid profile is neither stored nor applied
+        bike_computer::DrivetrainProfile invalidProfile = profile;
+        invalidProfile.nbrOfCogs                        = 0;
+        TEST_ASSERT_FALSE(bikeSystem.setDrivetrainProfile(invalidProfile));
+
+        // the profile is applied by the periodic thread
+        TEST_ASSERT_TRUE(bikeSystem.setDrivetrainProfile(profile));
+        ThisThread::sleep_for(20ms);
+        bike_computer::Speedometer& speedometer = bikeSystem.getSpeedometer();
+        TEST_ASSERT_FLOAT_WITHIN(
+            kAllowedWheelDelta, 2.0f, speedometer.getWheelCircumference());
+        const uint8_t gear = bikeSystem.getCurrentGear();
+        TEST_ASSERT_TRUE(gear <= profile.nbrOfCogs);
+        TEST_ASSERT_EQUAL_UINT8(profile.cassette[gear - bike_computer::kMinGear],
+                                speedometer.getGearSize());
+
+        bikeSystem.stop();
+        thread.join();
+    }
+
+    // the stored profile is loaded by the next system
+    multi_tasking::BikeSystem bikeSystem;
+    Thread thread;
+    thread.start(callback(&bikeSystem, &multi_tasking::BikeSystem::start));
+    ThisThread::sleep_for(2s);
+    TEST_ASSERT_FLOAT_WITHIN(
+        kAllowedWheelDelta, 2.0f, bikeSystem.getSpeedometer().getWheelCircumference());
+
+    // the other test cases use the default profile
+    TEST_ASSERT_TRUE(
+        bikeSystem.setDrivetrainProfile(bike_computer::Drivetrain::getDefaultProfile()));
+    ThisThread::sleep_for(20ms);
+    bikeSystem.stop();
+    thread.join();
+}
+
 // test_reset_multi_tasking_bike_system handler function
 Timer timer;
 static std::chrono::microseconds resetTime = std::chrono::microseconds::zero();
@@ -258,6 +315,9 @@ static void resetCallback() {
 }
 
 static void test_reset_multi_tasking_bike_system() {
+    // do not restore the state left by a previous test case
+    bike_computer::RetainedRideState::getInstance().invalidate();
+
     // create the BikeSystem instance
     multi_tasking::BikeSystem bikeSystem;
 
@@ -328,7 +388,9 @@ static Case cases[] = {
     Case("test bike system with event", test_bike_system_with_event),
     Case("test bike system multi tasking", test_multi_tasking_bike_system),
     Case("test bike system reset multi tasking", test_reset_multi_tasking_bike_system),
-    Case("test bike system gear multi tasking", test_gear_multi_tasking_bike_system)};
+    Case("test bike system gear multi tasking", test_gear_multi_tasking_bike_system),
+    Case("test bike system drivetrain profile multi tasking",
+         test_drivetrain_profile_multi_tasking_bike_system)};
 
 static Specification specification(greentea_setup, cases);
 
@@ -0,0 +1,175 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: publish/subscribe data bus
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <chrono>
+
+#include "common/data_bus.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+// value whose two halves must always be read together
+struct TestValue {
+    uint32_t counter;
+    uint32_t complement;
+};
+
+// test versions and latest-value semantics
+static control_t test_publish_read(const size_t call_count) {
+    bike_computer::Topic<bike_computer::GearState> topic;
+    bike_computer::GearState gearState = {0, 0};
+
+    // nothing published yet
+    uint32_t version = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, topic.getVersion());
+    TEST_ASSERT_FALSE(topic.readIfNewer(gearState, version));
+
+    // only the latest value is kept
+    for (uint8_t gear = 1; gear <= 3; gear++) {
+        topic.publish({gear, static_cast<uint8_t>(20 - gear)});
+    }
+    TEST_ASSERT_TRUE(topic.readIfNewer(gearState, version));
+    TEST_ASSERT_EQUAL_UINT32(3, version);
+    TEST_ASSERT_EQUAL_UINT8(3, gearState.gear);
+    TEST_ASSERT_EQUAL_UINT8(17, gearState.gearSize);
+    TEST_ASSERT_FALSE(topic.readIfNewer(gearState, version));
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a subscriber thread is woken up at each publish
+static constexpr uint32_t kSpeedFlag = (1UL << 0);
+static constexpr uint32_t kStopFlag  = (1UL << 1);
+
+static bike_computer::Topic<float> subscriber_topic;
+static EventFlags subscriber_event_flags;
+static volatile uint32_t nbr_of_wake_ups = 0;
+static float last_received_speed         = 0.0f;
+
+static void subscriber() {
+    uint32_t version = 0;
+    while (true) {
+        const uint32_t flags =
+            subscriber_event_flags.wait_any(kSpeedFlag | kStopFlag, osWaitForever);
+        if ((flags & kSpeedFlag) != 0) {
+            float speed = 0.0f;
+            if (subscriber_topic.readIfNewer(speed, version)) {
+                last_received_speed = speed;
+                nbr_of_wake_ups     = nbr_of_wake_ups + 1;
+            }
+        }
+        if ((flags & kStopFlag) != 0) {
+            return;
+        }
+    }
+}
+
+static control_t test_subscriber_wake_up(const size_t call_count) {
+    TEST_ASSERT_TRUE(subscriber_topic.subscribe(subscriber_event_flags, kSpeedFlag));
+
+    Thread thread(osPriorityAboveNormal, OS_STACK_SIZE, nullptr, "Subscriber");
+    thread.start(callback(subscriber));
+
+    // the subscriber has a higher priority, it runs at each publish
+    static constexpr uint32_t kNbrOfPublishes = 10;
+    for (uint32_t index = 1; index <= kNbrOfPublishes; index++) {
+        subscriber_topic.publish(static_cast<float>(index));
+        ThisThread::sleep_for(10ms);
+    }
+    subscriber_event_flags.set(kStopFlag);
+    thread.join();
+
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfPublishes, nbr_of_wake_ups);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, kNbrOfPublishes, last_received_speed);
+
+    // the number of subscribers is limited
+    EventFlags eventFlags;
+    for (uint8_t index = 1; index < bike_computer::Topic<float>::kMaxSubscribers;
+         index++) {
+        TEST_ASSERT_TRUE(subscriber_topic.subscribe(eventFlags, kSpeedFlag));
+    }
+    TEST_ASSERT_FALSE(subscriber_topic.subscribe(eventFlags, kSpeedFlag));
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// values published in interrupt context at 10 kHz must never be read torn
+static bike_computer::Topic<TestValue> ticker_topic;
+static uint32_t ticker_counter = 0;
+
+static void publish_value() {
+    ticker_counter++;
+    ticker_topic.publish({ticker_counter, ~ticker_counter});
+}
+
+static control_t test_interrupt_publish(const size_t call_count) {
+    Ticker ticker;
+    ticker.attach(publish_value, 100us);
+
+    Timer timer;
+    timer.start();
+    uint32_t nbrOfReads      = 0;
+    uint32_t previousVersion = 0;
+    while (timer.elapsed_time() < 1s) {
+        TestValue value;
+        const uint32_t version = ticker_topic.read(value);
+        TEST_ASSERT_EQUAL_UINT32(~value.counter, value.complement);
+        TEST_ASSERT_TRUE(version >= previousVersion);
+        TEST_ASSERT_EQUAL_UINT32(version, value.counter);
+        previousVersion = version;
+        nbrOfReads++;
+    }
+    ticker.detach();
+
+    printf("  %" PRIu32 " values published, %" PRIu32 " reads\n",
+           ticker_topic.getVersion(),
+           nbrOfReads);
+    TEST_ASSERT_TRUE(ticker_topic.getVersion() > 0);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {
+    Case("test data bus publish and read", test_publish_read),
+    Case("test data bus subscriber wake up", test_subscriber_wake_up),
+    Case("test data bus interrupt publish", test_interrupt_publish)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
@@ -0,0 +1,207 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: flash key-value store
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <cstring>
+
+#include "BlockDevice.h"
+#include "common/flash_kv_store.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+using bike_computer::FlashKVStore;
+using bike_computer::KVReturnCode;
+
+// block device emulating a flash in RAM (erase to 0xFF, program only erased
+// bytes), a program can be interrupted for emulating a reset
+class RAMFlashBlockDevice : public mbed::BlockDevice {
+   public:
+    static constexpr uint32_t kSize        = 4096;
+    static constexpr uint32_t kProgramSize = 32;
+    static constexpr uint32_t kEraseSize   = 1024;
+
+    int init() override { return 0; }
+    int deinit() override { return 0; }
+    int read(void* buffer, mbed::bd_addr_t addr, mbed::bd_size_t size) override {
+        memcpy(buffer, _memory + addr, size);
+        return 0;
+    }
+    int program(const void* buffer, mbed::bd_addr_t addr, mbed::bd_size_t size) override {
+        const uint8_t* data = static_cast<const uint8_t*>(buffer);
+        for (mbed::bd_size_t index = 0; index < size; index++) {
+            if (_programBudget == 0) {
+                return BD_ERROR_DEVICE_ERROR;
+            }
+            if (_programBudget > 0) {
+                _programBudget--;
+            }
+            if (_memory[addr + index] != 0xFF) {
+                _programmedNotErased = true;
+            }
+            _memory[addr + index] = data[index];
+        }
+        return 0;
+    }
+    int erase(mbed::bd_addr_t addr, mbed::bd_size_t size) override {
+        memset(_memory + addr, 0xFF, size);
+        return 0;
+    }
+    mbed::bd_size_t get_read_size() const override { return 1; }
+    mbed::bd_size_t get_program_size() const override { return kProgramSize; }
+    mbed::bd_size_t get_erase_size() const override { return kEraseSize; }
+    int get_erase_value() const override { return 0xFF; }
+    mbed::bd_size_t size() const override { return kSize; }
+    const char* get_type() const override { return "RAMFLASH"; }
+
+    // number of bytes programmed before a program fails, negative for no limit
+    void setProgramBudget(int32_t programBudget) { _programBudget = programBudget; }
+    bool hasProgrammedNotErased() const { return _programmedNotErased; }
+
+   private:
+    uint8_t _memory[kSize]    = {0};
+    int32_t _programBudget    = -1;
+    bool _programmedNotErased = false;
+};
+
+static RAMFlashBlockDevice ramFlashBlockDevice;
+static constexpr uint32_t kStoreSize = RAMFlashBlockDevice::kSize;
+
+static void check_value(FlashKVStore& kvStore,  // NOLINT(runtime/references)
+                        uint16_t key,
+                        uint32_t expectedValue) {
+    uint32_t value      = 0;
+    uint32_t actualSize = 0;
+    const KVReturnCode rc = kvStore.get(key, &value, sizeof(value), actualSize);
+    TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok), static_cast<int>(rc));
+    TEST_ASSERT_EQUAL(sizeof(value), actualSize);
+    TEST_ASSERT_EQUAL(expectedValue, value);
+}
+
+// test that the latest value of each key is read, also after a new init
+static control_t test_set_and_get(const size_t call_count) {
+    ramFlashBlockDevice.erase(0, kStoreSize);
+    {
+        FlashKVStore kvStore(ramFlashBlockDevice, 0, kStoreSize);
+        TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                          static_cast<int>(kvStore.init()));
+        uint32_t value      = 0;
+        uint32_t actualSize = 0;
+        const KVReturnCode rc = kvStore.get(1, &value, sizeof(value), actualSize);
+        TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::NotFound), static_cast<int>(rc));
+        for (uint32_t index = 0; index < 10; index++) {
+            value = index;
+            kvStore.set(1, &value, sizeof(value));
+            value = index * 2;
+            kvStore.set(2, &value, sizeof(value));
+        }
+        check_value(kvStore, 1, 9);
+        check_value(kvStore, 2, 18);
+    }
+
+    // values must survive a new init (as after a reset)
+    FlashKVStore kvStore(ramFlashBlockDevice, 0, kStoreSize);
+    TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                      static_cast<int>(kvStore.init()));
+    check_value(kvStore, 1, 9);
+    check_value(kvStore, 2, 18);
+    TEST_ASSERT_FALSE(ramFlashBlockDevice.hasProgrammedNotErased());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that compaction keeps the latest values when the areas fill up
+static control_t test_compaction(const size_t call_count) {
+    ramFlashBlockDevice.erase(0, kStoreSize);
+    FlashKVStore kvStore(ramFlashBlockDevice, 0, kStoreSize);
+    TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                      static_cast<int>(kvStore.init()));
+    static constexpr uint32_t kNbrOfWrites = 500;
+    for (uint32_t index = 0; index < kNbrOfWrites; index++) {
+        uint32_t value = index;
+        TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                          static_cast<int>(kvStore.set(1, &value, sizeof(value))));
+        check_value(kvStore, 1, index);
+    }
+    printf("  %" PRIu32 " compactions for %" PRIu32 " writes\n",
+           kvStore.getCompactionCount(),
+           kNbrOfWrites);
+    TEST_ASSERT_TRUE(kvStore.getCompactionCount() > 0);
+    TEST_ASSERT_FALSE(ramFlashBlockDevice.hasProgrammedNotErased());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a write interrupted by a reset does not corrupt the store
+static control_t test_interrupted_write(const size_t call_count) {
+    ramFlashBlockDevice.erase(0, kStoreSize);
+    {
+        FlashKVStore kvStore(ramFlashBlockDevice, 0, kStoreSize);
+        TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                          static_cast<int>(kvStore.init()));
+        uint32_t value = 42;
+        kvStore.set(1, &value, sizeof(value));
+
+        // the next record is only partially programmed
+        ramFlashBlockDevice.setProgramBudget(10);
+        value = 43;
+        TEST_ASSERT_NOT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                              static_cast<int>(kvStore.set(1, &value, sizeof(value))));
+        ramFlashBlockDevice.setProgramBudget(-1);
+    }
+
+    // the previous value is read and the store can be written again
+    FlashKVStore kvStore(ramFlashBlockDevice, 0, kStoreSize);
+    TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                      static_cast<int>(kvStore.init()));
+    check_value(kvStore, 1, 42);
+    uint32_t value = 44;
+    TEST_ASSERT_EQUAL(static_cast<int>(KVReturnCode::Ok),
+                      static_cast<int>(kvStore.set(1, &value, sizeof(value))));
+    check_value(kvStore, 1, 44);
+    TEST_ASSERT_FALSE(ramFlashBlockDevice.hasProgrammedNotErased());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test kv store set and get", test_set_and_get),
+                       Case("test kv store compaction", test_compaction),
+                       Case("test kv store interrupted write", test_interrupted_write)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
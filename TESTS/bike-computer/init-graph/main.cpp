@@ -0,0 +1,135 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: init job graph and startup timeline
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include <chrono>
+
+#include "common/init_graph.hpp"
+#include "common/startup_timeline.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+static constexpr std::chrono::milliseconds kJobDuration = 100ms;
+
+// records the order in which the jobs are done
+static volatile uint8_t nbr_of_done_jobs = 0;
+static uint8_t job_order[3]              = {};
+
+struct SleepingJob {
+    uint8_t jobIndex;
+
+    void run() {
+        ThisThread::sleep_for(kJobDuration);
+        core_util_critical_section_enter();
+        job_order[nbr_of_done_jobs] = jobIndex;
+        nbr_of_done_jobs            = nbr_of_done_jobs + 1;
+        core_util_critical_section_exit();
+    }
+};
+
+// test that independent jobs run concurrently and that a job runs after the jobs
+// it depends on
+static control_t test_init_graph(const size_t call_count) {
+    SleepingJob jobs[] = {{0}, {1}, {2}};
+    bike_computer::InitGraph initGraph;
+    const bike_computer::InitGraph::JobId firstJobId =
+        initGraph.addJob("First", callback(&jobs[0], &SleepingJob::run));
+    const bike_computer::InitGraph::JobId secondJobId =
+        initGraph.addJob("Second", callback(&jobs[1], &SleepingJob::run));
+    TEST_ASSERT_NOT_EQUAL(bike_computer::InitGraph::kInvalidJobId, firstJobId);
+    TEST_ASSERT_NOT_EQUAL(bike_computer::InitGraph::kInvalidJobId, secondJobId);
+    const uint32_t dependencies = bike_computer::InitGraph::dependsOn(firstJobId) |
+                                  bike_computer::InitGraph::dependsOn(secondJobId);
+    TEST_ASSERT_NOT_EQUAL(
+        bike_computer::InitGraph::kInvalidJobId,
+        initGraph.addJob("Third", callback(&jobs[2], &SleepingJob::run), dependencies));
+    // a job cannot depend on a job added after it
+    TEST_ASSERT_EQUAL(bike_computer::InitGraph::kInvalidJobId,
+                      initGraph.addJob("Invalid",
+                                       callback(&jobs[2], &SleepingJob::run),
+                                       bike_computer::InitGraph::dependsOn(3)));
+
+    Timer timer;
+    timer.start();
+    initGraph.run();
+    const std::chrono::microseconds duration = timer.elapsed_time();
+    printf("Init graph run in %lld usecs\n", duration.count());
+
+    // the first two jobs run together, the third one after them
+    TEST_ASSERT_EQUAL_UINT8(3, nbr_of_done_jobs);
+    TEST_ASSERT_EQUAL_UINT8(2, job_order[2]);
+    constexpr std::chrono::microseconds kMaxDuration = 2 * kJobDuration + 20ms;
+    TEST_ASSERT_TRUE(duration >= 2 * kJobDuration);
+    TEST_ASSERT_TRUE(duration < kMaxDuration);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static volatile uint8_t nbr_of_deferred_runs = 0;
+static void deferred_job() { nbr_of_deferred_runs = nbr_of_deferred_runs + 1; }
+
+// test that the deferred jobs only run once the first frame is shown
+static control_t test_deferred_jobs(const size_t call_count) {
+    bike_computer::StartupTimeline& startupTimeline =
+        bike_computer::StartupTimeline::getInstance();
+    TEST_ASSERT_FALSE(startupTimeline.isFirstFrameShown());
+
+    TEST_ASSERT_TRUE(startupTimeline.defer("Deferred", deferred_job));
+    ThisThread::sleep_for(100ms);
+    TEST_ASSERT_EQUAL_UINT8(0, nbr_of_deferred_runs);
+
+    startupTimeline.markFirstFrame();
+    TEST_ASSERT_TRUE(startupTimeline.isFirstFrameShown());
+    ThisThread::sleep_for(100ms);
+    TEST_ASSERT_EQUAL_UINT8(1, nbr_of_deferred_runs);
+
+    // once the first frame is shown, a deferred job runs immediately
+    TEST_ASSERT_TRUE(startupTimeline.defer("Deferred", deferred_job));
+    ThisThread::sleep_for(100ms);
+    TEST_ASSERT_EQUAL_UINT8(2, nbr_of_deferred_runs);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test init graph", test_init_graph),
+                       Case("test deferred jobs", test_deferred_jobs)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
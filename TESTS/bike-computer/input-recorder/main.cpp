@@ -0,0 +1,264 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: input recording and replay
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include <chrono>
+#include <cstring>
+
+#include "common/input_recorder.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "multi_tasking/bike_system.hpp"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+// allowed difference between a recorded and a replayed delay
+static constexpr uint32_t kDelayDeltaUs = 1000;
+
+// test the records of a few inputs
+static control_t test_input_recorder(const size_t call_count) {
+    bike_computer::InputRecorder inputRecorder;
+    // inputs are not recorded before start
+    inputRecorder.record(bike_computer::InputEvent::JoystickUp);
+    TEST_ASSERT_EQUAL_UINT16(0, inputRecorder.getNbrOfRecords());
+
+    inputRecorder.start();
+    ThisThread::sleep_for(20ms);
+    inputRecorder.record(bike_computer::InputEvent::JoystickUp);
+    ThisThread::sleep_for(50ms);
+    inputRecorder.record(bike_computer::InputEvent::ResetButton);
+    inputRecorder.stop();
+    inputRecorder.record(bike_computer::InputEvent::JoystickDown);
+
+    TEST_ASSERT_EQUAL_UINT16(2, inputRecorder.getNbrOfRecords());
+    const uint32_t* log = inputRecorder.getLog();
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(bike_computer::InputEvent::JoystickUp),
+                            bike_computer::InputRecorder::getInput(log[0]));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(bike_computer::InputEvent::ResetButton),
+                            bike_computer::InputRecorder::getInput(log[1]));
+    TEST_ASSERT_UINT32_WITHIN(
+        kDelayDeltaUs,
+        20000,
+        static_cast<uint32_t>(bike_computer::InputRecorder::getDelay(log[0]).count()));
+    TEST_ASSERT_UINT32_WITHIN(
+        kDelayDeltaUs,
+        50000,
+        static_cast<uint32_t>(bike_computer::InputRecorder::getDelay(log[1]).count()));
+    inputRecorder.printLog();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that recording stops when the log is full and keeps the first inputs
+static control_t test_input_recorder_full(const size_t call_count) {
+    static bike_computer::InputRecorder inputRecorder;
+    inputRecorder.start();
+    for (uint16_t index = 0; index < bike_computer::InputRecorder::kMaxRecords; index++) {
+        inputRecorder.record(bike_computer::InputEvent::JoystickUp);
+    }
+    TEST_ASSERT_TRUE(inputRecorder.isRecording());
+    TEST_ASSERT_FALSE(inputRecorder.isFull());
+
+    inputRecorder.record(bike_computer::InputEvent::JoystickDown);
+    inputRecorder.record(bike_computer::InputEvent::JoystickDown);
+    TEST_ASSERT_FALSE(inputRecorder.isRecording());
+    TEST_ASSERT_TRUE(inputRecorder.isFull());
+    TEST_ASSERT_EQUAL_UINT16(bike_computer::InputRecorder::kMaxRecords,
+                             inputRecorder.getNbrOfRecords());
+    const uint32_t* log = inputRecorder.getLog();
+    TEST_ASSERT_EQUAL_UINT8(
+        static_cast<uint8_t>(bike_computer::InputEvent::JoystickUp),
+        bike_computer::InputRecorder::getInput(
+            log[bike_computer::InputRecorder::kMaxRecords - 1]));
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a replay injects the inputs of a log with the recorded timing
+static control_t test_input_replayer(const size_t call_count) {
+    // 10 ms up, 30 ms down, 25 ms idle then 5 ms right, 40 ms reset
+    constexpr uint8_t kIdle      = bike_computer::InputRecorder::kIdleRecord;
+    static const uint32_t kLog[] = {(10000 << 3) | 0,
+                                    (30000 << 3) | 1,
+                                    (25000 << 3) | kIdle,
+                                    (5000 << 3) | 3,
+                                    (40000 << 3) | 4};
+
+    // the replayed inputs are recorded again
+    bike_computer::InputRecorder inputRecorder;
+    bike_computer::InputReplayer inputReplayer(
+        callback(&inputRecorder, &bike_computer::InputRecorder::record));
+    inputRecorder.start();
+    TEST_ASSERT_TRUE(inputReplayer.start(kLog, sizeof(kLog) / sizeof(kLog[0])));
+    TEST_ASSERT_FALSE(inputReplayer.start(kLog, sizeof(kLog) / sizeof(kLog[0])));
+    inputReplayer.waitForEnd();
+    TEST_ASSERT_FALSE(inputReplayer.isRunning());
+
+    // the idle time is part of the delay of the next input
+    static const uint8_t kExpectedInputs[]   = {0, 1, 3, 4};
+    static const uint32_t kExpectedDelays[]  = {10000, 30000, 30000, 40000};
+    constexpr uint16_t kNbrOfExpectedRecords = sizeof(kExpectedInputs);
+    TEST_ASSERT_EQUAL_UINT16(kNbrOfExpectedRecords, inputRecorder.getNbrOfRecords());
+    const uint32_t* log = inputRecorder.getLog();
+    for (uint16_t index = 0; index < kNbrOfExpectedRecords; index++) {
+        TEST_ASSERT_EQUAL_UINT8(kExpectedInputs[index],
+                                bike_computer::InputRecorder::getInput(log[index]));
+        TEST_ASSERT_UINT32_WITHIN(
+            kDelayDeltaUs,
+            kExpectedDelays[index],
+            static_cast<uint32_t>(
+                bike_computer::InputRecorder::getDelay(log[index]).count()));
+    }
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that the replay is anchored to the origin of the log: inputs whose time
+// passed are injected at once, the next ones at their time from the origin
+static control_t test_input_replayer_origin(const size_t call_count) {
+    // 10 ms up, 30 ms down, 30 ms right
+    static const uint32_t kLog[] = {
+        (10000 << 3) | 0, (30000 << 3) | 1, (30000 << 3) | 3};
+
+    bike_computer::InputRecorder inputRecorder;
+    bike_computer::InputReplayer inputReplayer(
+        callback(&inputRecorder, &bike_computer::InputRecorder::record));
+    inputRecorder.start();
+    ThisThread::sleep_for(20ms);
+    TEST_ASSERT_TRUE(inputReplayer.start(
+        kLog, sizeof(kLog) / sizeof(kLog[0]), inputRecorder.getElapsedTime()));
+    inputReplayer.waitForEnd();
+
+    // the first input is late (20 ms instead of 10 ms), the next ones are at 40 ms
+    // and 70 ms from the origin
+    static const uint32_t kExpectedDelays[]  = {20000, 20000, 30000};
+    constexpr uint16_t kNbrOfExpectedRecords = sizeof(kLog) / sizeof(kLog[0]);
+    TEST_ASSERT_EQUAL_UINT16(kNbrOfExpectedRecords, inputRecorder.getNbrOfRecords());
+    const uint32_t* log = inputRecorder.getLog();
+    for (uint16_t index = 0; index < kNbrOfExpectedRecords; index++) {
+        TEST_ASSERT_UINT32_WITHIN(
+            kDelayDeltaUs,
+            kExpectedDelays[index],
+            static_cast<uint32_t>(
+                bike_computer::InputRecorder::getDelay(log[index]).count()));
+    }
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that the inputs recorded by a bike system bring another bike system to the
+// same state when they are replayed
+static control_t test_bike_system_replay(const size_t call_count) {
+    static uint32_t recordedLog[bike_computer::InputRecorder::kMaxRecords] = {};
+    uint16_t nbrOfRecords                                                 = 0;
+    uint8_t recordedGear                                                  = 0;
+    {
+        bike_computer::RetainedRideState::getInstance().invalidate();
+        multi_tasking::BikeSystem bikeSystem;
+        Thread thread;
+        thread.start(callback(&bikeSystem, &multi_tasking::BikeSystem::start));
+        ThisThread::sleep_for(1s);
+
+        // scripted inputs, with various delays
+        multi_tasking::GearDevice& gearDevice = bikeSystem.getGearDevice();
+        gearDevice.onJoystickUp();
+        ThisThread::sleep_for(35ms);
+        gearDevice.onJoystickUp();
+        ThisThread::sleep_for(120ms);
+        bikeSystem.onReset();
+        ThisThread::sleep_for(10ms);
+        gearDevice.onJoystickUp();
+        gearDevice.onJoystickDown();
+        ThisThread::sleep_for(200ms);
+
+        bikeSystem.stop();
+        thread.join();
+        recordedGear = bikeSystem.getCurrentGear();
+        nbrOfRecords = bikeSystem.getInputRecorder().getNbrOfRecords();
+        memcpy(recordedLog,
+               bikeSystem.getInputRecorder().getLog(),
+               nbrOfRecords * sizeof(uint32_t));
+    }
+    TEST_ASSERT_EQUAL_UINT16(5, nbrOfRecords);
+
+    bike_computer::RetainedRideState::getInstance().invalidate();
+    multi_tasking::BikeSystem bikeSystem;
+    Thread thread;
+    thread.start(callback(&bikeSystem, &multi_tasking::BikeSystem::start));
+    // the inputs are replayed with their delay from the init of the first system,
+    // which is reached before the first input
+    ThisThread::sleep_for(100ms);
+    TEST_ASSERT_TRUE(bikeSystem.replayInputs(recordedLog, nbrOfRecords));
+    bikeSystem.getInputReplayer().waitForEnd();
+    ThisThread::sleep_for(100ms);
+
+    // same inputs, same state
+    TEST_ASSERT_EQUAL_UINT8(recordedGear, bikeSystem.getCurrentGear());
+    const bike_computer::InputRecorder& inputRecorder = bikeSystem.getInputRecorder();
+    const uint32_t* replayedLog                       = inputRecorder.getLog();
+    TEST_ASSERT_EQUAL_UINT16(nbrOfRecords, inputRecorder.getNbrOfRecords());
+    // the first delay is also measured from the init of the system
+    for (uint16_t index = 0; index < nbrOfRecords; index++) {
+        TEST_ASSERT_EQUAL_UINT8(
+            bike_computer::InputRecorder::getInput(recordedLog[index]),
+            bike_computer::InputRecorder::getInput(replayedLog[index]));
+        TEST_ASSERT_UINT32_WITHIN(
+            kDelayDeltaUs,
+            static_cast<uint32_t>(
+                bike_computer::InputRecorder::getDelay(recordedLog[index]).count()),
+            static_cast<uint32_t>(
+                bike_computer::InputRecorder::getDelay(replayedLog[index]).count()));
+    }
+
+    bikeSystem.stop();
+    thread.join();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test input recorder", test_input_recorder),
+                       Case("test input recorder full", test_input_recorder_full),
+                       Case("test input replayer", test_input_replayer),
+                       Case("test input replayer origin", test_input_replayer_origin),
+                       Case("test bike system replay", test_bike_system_replay)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
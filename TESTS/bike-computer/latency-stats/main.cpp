@@ -0,0 +1,139 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: latency statistics and percentiles
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include <chrono>
+
+#include "common/latency_stats.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+// a percentile is at most one bucket (1/16) above the exact value
+static void check_percentile(const bike_computer::LatencyStats& latencyStats,
+                             float percentile,
+                             uint32_t expectedLatency) {
+    const uint32_t latency =
+        static_cast<uint32_t>(latencyStats.getPercentile(percentile).count());
+    TEST_ASSERT_TRUE(latency >= expectedLatency);
+    TEST_ASSERT_TRUE(latency <= expectedLatency + expectedLatency / 16);
+}
+
+// test min, max, average and percentiles of a uniform distribution
+static control_t test_uniform_latencies(const size_t call_count) {
+    bike_computer::LatencyStats latencyStats;
+    TEST_ASSERT_EQUAL_UINT32(0, latencyStats.getPercentile(50.0f).count());
+
+    // 1 to 10000 us, in a shuffled order
+    constexpr uint32_t kNbrOfSamples = 10000;
+    constexpr uint32_t kStride       = 7919;  // prime, visits all values
+    for (uint32_t index = 0; index < kNbrOfSamples; index++) {
+        latencyStats.record(
+            std::chrono::microseconds((index * kStride) % kNbrOfSamples + 1));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfSamples, latencyStats.getCount());
+    TEST_ASSERT_EQUAL_UINT32(1, latencyStats.getMin().count());
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfSamples, latencyStats.getMax().count());
+    TEST_ASSERT_EQUAL_UINT32(5000, latencyStats.getAverage().count());
+    check_percentile(latencyStats, 50.0f, 5000);
+    check_percentile(latencyStats, 99.0f, 9900);
+    check_percentile(latencyStats, 99.9f, 9990);
+    // the extremes are exact
+    TEST_ASSERT_EQUAL_UINT32(1, latencyStats.getPercentile(0.0f).count());
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfSamples, latencyStats.getPercentile(100.0f).count());
+    latencyStats.printStats("Uniform");
+
+    latencyStats.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, latencyStats.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, latencyStats.getPercentile(99.0f).count());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a rare long latency shows in the tail percentiles only
+static control_t test_tail_latencies(const size_t call_count) {
+    bike_computer::LatencyStats latencyStats;
+    constexpr uint32_t kNbrOfSamples = 2000;
+    for (uint32_t index = 0; index < kNbrOfSamples; index++) {
+        // one sample in 1000 is delayed by a long task
+        const uint32_t latency = (index % 1000 == 999) ? 250000 : 12;
+        latencyStats.record(std::chrono::microseconds(latency));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(12, latencyStats.getPercentile(50.0f).count());
+    TEST_ASSERT_EQUAL_UINT32(12, latencyStats.getPercentile(99.0f).count());
+    check_percentile(latencyStats, 99.95f, 250000);
+    TEST_ASSERT_EQUAL_UINT32(250000, latencyStats.getMax().count());
+    latencyStats.printStats("Tail");
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that latencies beyond the histogram range are reported as the max, not as
+// the upper bound of the last bucket
+static control_t test_overflow_latencies(const size_t call_count) {
+    bike_computer::LatencyStats latencyStats;
+    constexpr uint32_t kNbrOfSamples    = 100;
+    constexpr uint32_t kOverflowLatency = 10000000;  // 10 s, above 2^22 us
+    for (uint32_t index = 0; index < kNbrOfSamples; index++) {
+        // the last 10 samples overflow, the longest one last
+        const uint32_t latency = index < 90 ? 1000 : kOverflowLatency + index;
+        latencyStats.record(std::chrono::microseconds(latency));
+    }
+
+    check_percentile(latencyStats, 50.0f, 1000);
+    TEST_ASSERT_EQUAL_UINT32(kOverflowLatency + kNbrOfSamples - 1,
+                             latencyStats.getMax().count());
+    TEST_ASSERT_EQUAL_UINT32(kOverflowLatency + kNbrOfSamples - 1,
+                             latencyStats.getPercentile(99.0f).count());
+    TEST_ASSERT_EQUAL_UINT32(kOverflowLatency + kNbrOfSamples - 1,
+                             latencyStats.getPercentile(99.9f).count());
+    latencyStats.printStats("Overflow");
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test uniform latencies", test_uniform_latencies),
+                       Case("test tail latencies", test_tail_latencies),
+                       Case("test overflow latencies", test_overflow_latencies)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
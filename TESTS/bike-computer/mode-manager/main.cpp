@@ -0,0 +1,163 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: operating modes
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <chrono>
+
+#include "common/constants.hpp"
+#include "common/mode_manager.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+// test the mode selected from the time without input and the speed
+static control_t test_select_mode(const size_t call_count) {
+    Timer timer;
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, 10ms);
+    bike_computer::Speedometer speedometer(timer);
+    bike_computer::ModeManager modeManager(timerWheel, speedometer, timer, 30s, 300s);
+
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Riding ==
+                     modeManager.selectMode(10s, 20.0f));
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Paused ==
+                     modeManager.selectMode(10s, 0.0f));
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Paused ==
+                     modeManager.selectMode(30s, 20.0f));
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Parked ==
+                     modeManager.selectMode(300s, 20.0f));
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Parked ==
+                     modeManager.selectMode(300s, 0.0f));
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// counts the runs of the task
+static volatile uint32_t nbr_of_task_runs = 0;
+static void task() { nbr_of_task_runs = nbr_of_task_runs + 1; }
+
+// number of task runs during duration
+static uint32_t count_task_runs(const std::chrono::milliseconds& duration) {
+    const uint32_t nbrOfTaskRuns = nbr_of_task_runs;
+    ThisThread::sleep_for(duration);
+    return nbr_of_task_runs - nbrOfTaskRuns;
+}
+
+// test that the system starts paused while the speed is zero and riding once an
+// input gave a speed
+static control_t test_initial_mode(const size_t call_count) {
+    Timer timer;
+    timer.start();
+    EventQueue eventQueue;
+    const bike_computer::ModeTask modeTasks[] = {
+        {"Task", callback(task), {100ms, 200ms, 500ms}, 0ms}};
+
+    // no input yet
+    bike_computer::TimerWheel stoppedTimerWheel(eventQueue, 10ms);
+    bike_computer::Speedometer stoppedSpeedometer(timer);
+    bike_computer::ModeManager stoppedModeManager(
+        stoppedTimerWheel, stoppedSpeedometer, timer, 30s, 300s);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stoppedSpeedometer.getCurrentSpeed());
+    TEST_ASSERT_TRUE(stoppedModeManager.start(modeTasks, 1));
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Paused ==
+                     stoppedModeManager.getMode());
+
+    // a pedal input before the start
+    bike_computer::TimerWheel movingTimerWheel(eventQueue, 10ms);
+    bike_computer::Speedometer movingSpeedometer(timer);
+    movingSpeedometer.setCurrentRotationTime(bike_computer::kMinPedalRotationTime);
+    bike_computer::ModeManager movingModeManager(
+        movingTimerWheel, movingSpeedometer, timer, 30s, 300s);
+    TEST_ASSERT_TRUE(movingModeManager.start(modeTasks, 1));
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Riding ==
+                     movingModeManager.getMode());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test the mode transitions and the task periods in each mode
+static control_t test_mode_periods(const size_t call_count) {
+    Timer timer;
+    timer.start();
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, 10ms);
+    // a pedal input gives a speed before the start
+    bike_computer::Speedometer speedometer(timer);
+    speedometer.setCurrentRotationTime(bike_computer::kMinPedalRotationTime);
+    bike_computer::ModeManager modeManager(timerWheel, speedometer, timer, 1s, 2s);
+
+    const bike_computer::ModeTask modeTasks[] = {
+        {"Task", callback(task), {100ms, 200ms, 500ms}, 0ms}};
+    TEST_ASSERT_TRUE(modeManager.start(modeTasks, 1));
+
+    Thread thread(osPriorityAboveNormal, OS_STACK_SIZE, nullptr, "TimerWheel");
+    TEST_ASSERT_TRUE(timerWheel.start());
+    thread.start(callback(&eventQueue, &EventQueue::dispatch_forever));
+
+    // the mode is evaluated every second: riding until 1 s, paused until 2 s,
+    // then parked
+    ThisThread::sleep_for(50ms);
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Riding == modeManager.getMode());
+    TEST_ASSERT_UINT32_WITHIN(1, 8, count_task_runs(800ms));
+    ThisThread::sleep_for(300ms);
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Paused == modeManager.getMode());
+    TEST_ASSERT_UINT32_WITHIN(1, 4, count_task_runs(800ms));
+    ThisThread::sleep_for(200ms);
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Parked == modeManager.getMode());
+    TEST_ASSERT_UINT32_WITHIN(1, 4, count_task_runs(2000ms));
+
+    // an input brings the bike back to riding at the next evaluation
+    modeManager.onActivity();
+    ThisThread::sleep_for(1s);
+    TEST_ASSERT_TRUE(bike_computer::OperatingMode::Riding == modeManager.getMode());
+    TEST_ASSERT_UINT32_WITHIN(1, 8, count_task_runs(800ms));
+
+    timerWheel.stop();
+    eventQueue.break_dispatch();
+    thread.join();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test mode selection", test_select_mode),
+                       Case("test initial mode", test_initial_mode),
+                       Case("test mode task periods", test_mode_periods)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
@@ -0,0 +1,183 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: overload detection and degradation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <chrono>
+
+#include "common/overload_manager.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+static constexpr std::chrono::milliseconds kLatenessThreshold = 50ms;
+
+static void nop() {}
+
+// test the overload level raised after late windows and lowered after on time windows
+static control_t test_overload_levels(const size_t call_count) {
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, 10ms);
+    bike_computer::OverloadManager overloadManager(timerWheel, kLatenessThreshold);
+    TEST_ASSERT_TRUE(overloadManager.addTask(timerWheel.addTimer("Task", nop, 100ms, 0ms),
+                                             bike_computer::TaskCriticality::Degradable));
+    TEST_ASSERT_FALSE(overloadManager.addTask(bike_computer::TimerWheel::kInvalidTimerId,
+                                              bike_computer::TaskCriticality::Optional));
+
+    // a single late window is not an overload
+    overloadManager.onEvaluationPeriod(100ms);
+    TEST_ASSERT_EQUAL_UINT8(0, overloadManager.getLevel());
+    overloadManager.onEvaluationPeriod(10ms);
+    overloadManager.onEvaluationPeriod(100ms);
+    TEST_ASSERT_EQUAL_UINT8(0, overloadManager.getLevel());
+
+    // two late windows in a row raise the level, up to the maximum level
+    overloadManager.onEvaluationPeriod(100ms);
+    TEST_ASSERT_EQUAL_UINT8(1, overloadManager.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(1, overloadManager.getNbrOfOverloads());
+    for (uint8_t index = 0; index < 10; index++) {
+        overloadManager.onEvaluationPeriod(100ms);
+    }
+    TEST_ASSERT_EQUAL_UINT8(bike_computer::OverloadManager::kMaxLevel,
+                            overloadManager.getLevel());
+
+    // the level is lowered one step at a time, a late window restarts the recovery
+    for (uint8_t index = 0; index < 5; index++) {
+        overloadManager.onEvaluationPeriod(10ms);
+    }
+    overloadManager.onEvaluationPeriod(100ms);
+    for (uint8_t index = 0; index < 5; index++) {
+        overloadManager.onEvaluationPeriod(10ms);
+    }
+    TEST_ASSERT_EQUAL_UINT8(bike_computer::OverloadManager::kMaxLevel,
+                            overloadManager.getLevel());
+    overloadManager.onEvaluationPeriod(10ms);
+    TEST_ASSERT_EQUAL_UINT8(bike_computer::OverloadManager::kMaxLevel - 1,
+                            overloadManager.getLevel());
+    for (uint8_t index = 0; index < 6 * bike_computer::OverloadManager::kMaxLevel;
+         index++) {
+        overloadManager.onEvaluationPeriod(10ms);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, overloadManager.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(1, overloadManager.getNbrOfOverloads());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// counts the runs of the tasks
+static volatile uint32_t nbr_of_degradable_runs = 0;
+static volatile uint32_t nbr_of_optional_runs   = 0;
+static void degradable_task() { nbr_of_degradable_runs = nbr_of_degradable_runs + 1; }
+static void optional_task() { nbr_of_optional_runs = nbr_of_optional_runs + 1; }
+
+// feeds evaluation windows from the thread of the timer wheel
+struct LoadSimulator {
+    bike_computer::OverloadManager* overloadManager;
+    std::chrono::microseconds lateness;
+    uint8_t nbrOfWindows;
+
+    void run() {
+        for (uint8_t index = 0; index < nbrOfWindows; index++) {
+            overloadManager->onEvaluationPeriod(lateness);
+        }
+    }
+};
+
+// test the effect of the overload level on the degradable and optional tasks
+static control_t test_degradation(const size_t call_count) {
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, 10ms);
+    bike_computer::OverloadManager overloadManager(timerWheel, kLatenessThreshold);
+    const bike_computer::TimerWheel::TimerId degradableId =
+        timerWheel.addTimer("Degradable", degradable_task, 100ms, 0ms);
+    const bike_computer::TimerWheel::TimerId optionalId =
+        timerWheel.addTimer("Optional", optional_task, 100ms, 0ms);
+    TEST_ASSERT_TRUE(overloadManager.addTask(degradableId,
+                                             bike_computer::TaskCriticality::Degradable));
+    TEST_ASSERT_TRUE(
+        overloadManager.addTask(optionalId, bike_computer::TaskCriticality::Optional));
+
+    Thread thread(osPriorityAboveNormal, OS_STACK_SIZE, nullptr, "TimerWheel");
+    TEST_ASSERT_TRUE(timerWheel.start());
+    thread.start(callback(&eventQueue, &EventQueue::dispatch_forever));
+
+    // not overloaded: both tasks run every 100 ms
+    ThisThread::sleep_for(50ms);
+    uint32_t nbrOfDegradableRuns = nbr_of_degradable_runs;
+    uint32_t nbrOfOptionalRuns   = nbr_of_optional_runs;
+    ThisThread::sleep_for(1000ms);
+    TEST_ASSERT_UINT32_WITHIN(1, 10, nbr_of_degradable_runs - nbrOfDegradableRuns);
+    TEST_ASSERT_UINT32_WITHIN(1, 10, nbr_of_optional_runs - nbrOfOptionalRuns);
+
+    // overloaded: the degradable task runs every 200 ms, the optional task is skipped
+    LoadSimulator overload = {&overloadManager, 100ms, 2};
+    eventQueue.call(callback(&overload, &LoadSimulator::run));
+    ThisThread::sleep_for(250ms);
+    TEST_ASSERT_EQUAL_UINT8(1, overloadManager.getLevel());
+    nbrOfDegradableRuns = nbr_of_degradable_runs;
+    nbrOfOptionalRuns   = nbr_of_optional_runs;
+    ThisThread::sleep_for(1000ms);
+    TEST_ASSERT_UINT32_WITHIN(1, 5, nbr_of_degradable_runs - nbrOfDegradableRuns);
+    TEST_ASSERT_EQUAL_UINT32(0, nbr_of_optional_runs - nbrOfOptionalRuns);
+
+    bike_computer::TimerStats stats;
+    TEST_ASSERT_TRUE(timerWheel.getStats(optionalId, stats));
+    TEST_ASSERT_UINT32_WITHIN(3, 12, stats.nbrOfSkippedRuns);
+
+    // recovered: both tasks run every 100 ms again
+    LoadSimulator recovery = {&overloadManager, 10ms, 6};
+    eventQueue.call(callback(&recovery, &LoadSimulator::run));
+    ThisThread::sleep_for(250ms);
+    TEST_ASSERT_EQUAL_UINT8(0, overloadManager.getLevel());
+    nbrOfDegradableRuns = nbr_of_degradable_runs;
+    nbrOfOptionalRuns   = nbr_of_optional_runs;
+    ThisThread::sleep_for(1000ms);
+    TEST_ASSERT_UINT32_WITHIN(1, 10, nbr_of_degradable_runs - nbrOfDegradableRuns);
+    TEST_ASSERT_UINT32_WITHIN(1, 10, nbr_of_optional_runs - nbrOfOptionalRuns);
+
+    timerWheel.stop();
+    eventQueue.break_dispatch();
+    thread.join();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test overload levels", test_overload_levels),
+                       Case("test task degradation", test_degradation)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
@@ -0,0 +1,193 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: sensor pulse filter
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <chrono>
+
+#include "common/constants.hpp"
+#include "common/pulse_filter.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "us_ticker_api.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+static constexpr std::chrono::microseconds kDebounceTime = 50us;
+static constexpr std::chrono::microseconds kStopTimeout =
+    2 * bike_computer::kMaxPedalRotationTime;
+
+// test the measured period of a regular pulse train, with timestamps wrapping
+// around
+static control_t test_period(const size_t call_count) {
+    bike_computer::PulseFilter pulseFilter(kDebounceTime, kStopTimeout);
+
+    static constexpr uint32_t kPeriod      = 750000;
+    static constexpr uint32_t kNbrOfPulses = 20;
+    uint32_t timestamp                     = 0xFFFFFFFF - 5 * kPeriod;
+    TEST_ASSERT_FALSE(pulseFilter.onEdge(timestamp));
+    for (uint32_t pulse = 1; pulse < kNbrOfPulses; pulse++) {
+        timestamp += kPeriod;
+        TEST_ASSERT_TRUE(pulseFilter.onEdge(timestamp));
+        TEST_ASSERT_EQUAL_UINT32(kPeriod, pulseFilter.getLastPeriod().count());
+    }
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfPulses, pulseFilter.getPulseCount());
+    TEST_ASSERT_EQUAL_UINT32(0, pulseFilter.getBounceCount());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that contact bounces are rejected and do not alter the period
+static control_t test_bounces(const size_t call_count) {
+    bike_computer::PulseFilter pulseFilter(kDebounceTime, kStopTimeout);
+
+    static constexpr uint32_t kPeriod          = 400000;
+    static constexpr uint32_t kNbrOfPulses     = 50;
+    static constexpr uint32_t kBouncesPerPulse = 3;
+    static constexpr uint32_t kBounceInterval  = 10;
+    uint32_t timestamp                         = 1000;
+    for (uint32_t pulse = 0; pulse < kNbrOfPulses; pulse++) {
+        pulseFilter.onEdge(timestamp);
+        for (uint32_t bounce = 1; bounce <= kBouncesPerPulse; bounce++) {
+            TEST_ASSERT_FALSE(pulseFilter.onEdge(timestamp + bounce * kBounceInterval));
+        }
+        timestamp += kPeriod;
+    }
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfPulses, pulseFilter.getPulseCount());
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfPulses * kBouncesPerPulse,
+                             pulseFilter.getBounceCount());
+    TEST_ASSERT_EQUAL_UINT32(kPeriod, pulseFilter.getLastPeriod().count());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test a synthetic train at 10 kHz: no pulse may be lost
+static control_t test_synthetic_high_rate(const size_t call_count) {
+    bike_computer::PulseFilter pulseFilter(kDebounceTime, kStopTimeout);
+
+    static constexpr uint32_t kPeriod      = 100;
+    static constexpr uint32_t kNbrOfPulses = 100000;
+    uint32_t timestamp                     = 0;
+    for (uint32_t pulse = 0; pulse < kNbrOfPulses; pulse++) {
+        pulseFilter.onEdge(timestamp);
+        timestamp += kPeriod;
+    }
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfPulses, pulseFilter.getPulseCount());
+    TEST_ASSERT_EQUAL_UINT32(0, pulseFilter.getBounceCount());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that the crank is reported as stopped once when no pulse is accepted for
+// the stop timeout, and that the measurement restarts with the next pulses
+static control_t test_stop_timeout(const size_t call_count) {
+    bike_computer::PulseFilter pulseFilter(kDebounceTime, kStopTimeout);
+
+    static constexpr uint32_t kPeriod      = 750000;
+    static constexpr uint32_t kStopTime    = kStopTimeout.count();
+    static constexpr uint32_t kNbrOfPulses = 5;
+    // no pulse yet: nothing to stop
+    TEST_ASSERT_FALSE(pulseFilter.checkStopped(10 * kStopTime));
+
+    uint32_t timestamp = 0xFFFFFFFF - 2 * kPeriod;
+    for (uint32_t pulse = 0; pulse < kNbrOfPulses; pulse++) {
+        pulseFilter.onEdge(timestamp);
+        TEST_ASSERT_FALSE(pulseFilter.checkStopped(timestamp + kPeriod));
+        timestamp += kPeriod;
+    }
+    TEST_ASSERT_EQUAL_UINT32(kPeriod, pulseFilter.getLastPeriod().count());
+
+    // the last pulse was accepted one period ago
+    const uint32_t lastPulse = timestamp - kPeriod;
+    TEST_ASSERT_FALSE(pulseFilter.checkStopped(lastPulse + kStopTime - 1));
+    TEST_ASSERT_TRUE(pulseFilter.checkStopped(lastPulse + kStopTime));
+    TEST_ASSERT_EQUAL_UINT32(0, pulseFilter.getLastPeriod().count());
+    // reported only once
+    TEST_ASSERT_FALSE(pulseFilter.checkStopped(lastPulse + 2 * kStopTime));
+
+    // the first pulse after the stop does not give a period
+    timestamp = lastPulse + 3 * kStopTime;
+    TEST_ASSERT_FALSE(pulseFilter.onEdge(timestamp));
+    TEST_ASSERT_EQUAL_UINT32(0, pulseFilter.getLastPeriod().count());
+    timestamp += kPeriod;
+    TEST_ASSERT_TRUE(pulseFilter.onEdge(timestamp));
+    TEST_ASSERT_EQUAL_UINT32(kPeriod, pulseFilter.getLastPeriod().count());
+    TEST_ASSERT_EQUAL_UINT32(kNbrOfPulses + 2, pulseFilter.getPulseCount());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// pulses injected in interrupt context at 5 kHz, timestamped as the sensor
+// interrupt handler does: no pulse may be lost
+static bike_computer::PulseFilter ticker_pulse_filter(kDebounceTime, kStopTimeout);
+static volatile uint32_t nbr_of_injected_pulses = 0;
+
+static void inject_pulse() {
+    nbr_of_injected_pulses = nbr_of_injected_pulses + 1;
+    ticker_pulse_filter.onEdge(us_ticker_read());
+}
+
+static control_t test_interrupt_high_rate(const size_t call_count) {
+    ticker_pulse_filter.reset();
+    nbr_of_injected_pulses = 0;
+
+    Ticker ticker;
+    ticker.attach(inject_pulse, 200us);
+    ThisThread::sleep_for(1s);
+    ticker.detach();
+
+    printf("  %" PRIu32 " pulses injected, %" PRIu32 " counted, %" PRIu32 " bounces\n",
+           nbr_of_injected_pulses,
+           ticker_pulse_filter.getPulseCount(),
+           ticker_pulse_filter.getBounceCount());
+    TEST_ASSERT_TRUE(nbr_of_injected_pulses > 0);
+    TEST_ASSERT_EQUAL_UINT32(nbr_of_injected_pulses, ticker_pulse_filter.getPulseCount());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {
+    Case("test pulse filter period", test_period),
+    Case("test pulse filter bounces", test_bounces),
+    Case("test pulse filter synthetic high rate", test_synthetic_high_rate),
+    Case("test pulse filter stop timeout", test_stop_timeout),
+    Case("test pulse filter interrupt high rate", test_interrupt_high_rate)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
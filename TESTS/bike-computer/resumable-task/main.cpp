@@ -0,0 +1,123 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: resumable tasks
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include <chrono>
+
+#include "common/resumable_task.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+static constexpr std::chrono::milliseconds kWaitDuration = 50ms;
+static constexpr uint8_t kNbrOfSteps                     = 3;
+
+// a sequence of steps separated by waits, records the order of the events
+struct SteppedOperation {
+    uint8_t stepIndexes[kNbrOfSteps] = {};
+    uint8_t nbrOfSteps               = 0;
+    uint8_t nbrOfOtherEvents         = 0;
+    // number of other events handled when the operation was done
+    uint8_t otherEventsWhenDone = 0;
+
+    bike_computer::TaskStep step(uint8_t stepIndex) {
+        stepIndexes[nbrOfSteps] = stepIndex;
+        nbrOfSteps++;
+        if (nbrOfSteps == kNbrOfSteps) {
+            return bike_computer::TaskStep::done();
+        }
+        return bike_computer::TaskStep::waitFor(kWaitDuration);
+    }
+
+    void onDone() { otherEventsWhenDone = nbrOfOtherEvents; }
+
+    void otherEvent() { nbrOfOtherEvents++; }
+};
+
+// test that the steps run in order and that the thread handles other events
+// during the waits
+static control_t test_resumable_task(const size_t call_count) {
+    EventQueue eventQueue;
+    Thread thread;
+    thread.start(callback(&eventQueue, &EventQueue::dispatch_forever));
+
+    SteppedOperation operation;
+    Callback<bike_computer::TaskStep(uint8_t)> step =
+        callback(&operation, &SteppedOperation::step);
+    Callback<void()> onDone = callback(&operation, &SteppedOperation::onDone);
+    bike_computer::ResumableTask resumableTask(eventQueue, "SteppedOperation");
+    TEST_ASSERT_TRUE(resumableTask.start(step, onDone));
+    TEST_ASSERT_TRUE(resumableTask.isRunning());
+
+    // other events posted during the first wait
+    ThisThread::sleep_for(kWaitDuration / 2);
+    constexpr uint8_t kNbrOfOtherEvents = 4;
+    for (uint8_t index = 0; index < kNbrOfOtherEvents; index++) {
+        eventQueue.call(callback(&operation, &SteppedOperation::otherEvent));
+    }
+
+    // a running task is not started again
+    TEST_ASSERT_FALSE(resumableTask.start(step, onDone));
+    TEST_ASSERT_EQUAL_UINT32(1, resumableTask.getNbrOfOverruns());
+
+    ThisThread::sleep_for(kWaitDuration * kNbrOfSteps);
+    TEST_ASSERT_FALSE(resumableTask.isRunning());
+    TEST_ASSERT_EQUAL_UINT8(kNbrOfSteps, operation.nbrOfSteps);
+    for (uint8_t index = 0; index < kNbrOfSteps; index++) {
+        TEST_ASSERT_EQUAL_UINT8(index, operation.stepIndexes[index]);
+    }
+    // the other events were handled before the operation was done
+    TEST_ASSERT_EQUAL_UINT8(kNbrOfOtherEvents, operation.otherEventsWhenDone);
+
+    // the next run starts again from the first step
+    operation.nbrOfSteps = 0;
+    TEST_ASSERT_TRUE(resumableTask.start(step, onDone));
+    ThisThread::sleep_for(kWaitDuration * kNbrOfSteps);
+    TEST_ASSERT_EQUAL_UINT8(kNbrOfSteps, operation.nbrOfSteps);
+    TEST_ASSERT_EQUAL_UINT8(0, operation.stepIndexes[0]);
+
+    eventQueue.break_dispatch();
+    thread.join();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test resumable task", test_resumable_task)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
@@ -0,0 +1,156 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: retained ride state and warm restart
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include <chrono>
+
+#include "common/retained_ride_state.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "multi_tasking/bike_system.hpp"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+// test that the state saved last is loaded and that invalidate discards it
+static control_t test_save_load(const size_t call_count) {
+    bike_computer::RetainedRideState& retainedRideState =
+        bike_computer::RetainedRideState::getInstance();
+    retainedRideState.invalidate();
+    bike_computer::RideState rideState = {};
+    TEST_ASSERT_FALSE(retainedRideState.load(rideState));
+
+    // the records are written in turn, the last saved state is always loaded
+    for (uint8_t index = 1; index <= 5; index++) {
+        const bike_computer::RideState savedState = {
+            1.5f * index, 300U + index, index, {0, 0, 0}};
+        retainedRideState.save(savedState);
+        TEST_ASSERT_TRUE(retainedRideState.load(rideState));
+        TEST_ASSERT_EQUAL_FLOAT(savedState.distance, rideState.distance);
+        TEST_ASSERT_EQUAL_UINT32(savedState.pedalRotationTime,
+                                 rideState.pedalRotationTime);
+        TEST_ASSERT_EQUAL_UINT8(savedState.gear, rideState.gear);
+    }
+
+    retainedRideState.invalidate();
+    TEST_ASSERT_FALSE(retainedRideState.load(rideState));
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that the missed task id is kept next to the ride state and reported once
+static control_t test_missed_task(const size_t call_count) {
+    bike_computer::RetainedRideState& retainedRideState =
+        bike_computer::RetainedRideState::getInstance();
+    uint8_t taskId = 0;
+    retainedRideState.takeMissedTask(taskId);
+    TEST_ASSERT_FALSE(retainedRideState.takeMissedTask(taskId));
+
+    // the ride state records do not overwrite the missed task
+    const bike_computer::RideState savedState = {2.5f, 450U, 4, {0, 0, 0}};
+    retainedRideState.saveMissedTask(2);
+    retainedRideState.save(savedState);
+    retainedRideState.save(savedState);
+    bike_computer::RideState rideState = {};
+    TEST_ASSERT_TRUE(retainedRideState.load(rideState));
+    TEST_ASSERT_EQUAL_FLOAT(savedState.distance, rideState.distance);
+
+    TEST_ASSERT_TRUE(retainedRideState.takeMissedTask(taskId));
+    TEST_ASSERT_EQUAL_UINT8(2, taskId);
+    TEST_ASSERT_FALSE(retainedRideState.takeMissedTask(taskId));
+    retainedRideState.invalidate();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a restarted bike system continues with the gear and the distance of
+// the previous instance and skips the initialization of the devices
+static control_t test_warm_restart(const size_t call_count) {
+    bike_computer::RetainedRideState::getInstance().invalidate();
+
+    std::chrono::microseconds coldInitDuration = std::chrono::microseconds::zero();
+    uint8_t gear                                = 0;
+    float distance                              = 0.0f;
+    {
+        multi_tasking::BikeSystem bikeSystem;
+        Thread thread;
+        thread.start(callback(&bikeSystem, &multi_tasking::BikeSystem::start));
+        ThisThread::sleep_for(1s);
+
+        // change the gear and let the bike ride for a while
+        constexpr uint8_t kNbrOfGearUp = 3;
+        for (uint8_t index = 0; index < kNbrOfGearUp; index++) {
+            bikeSystem.getGearDevice().onJoystickUp();
+            ThisThread::sleep_for(20ms);
+        }
+        ThisThread::sleep_for(3s);
+
+        bikeSystem.stop();
+        thread.join();
+        coldInitDuration = bikeSystem.getInitDuration();
+        gear             = bikeSystem.getCurrentGear();
+        distance         = bikeSystem.getSpeedometer().getDistance();
+    }
+    TEST_ASSERT_TRUE(distance > 0.0f);
+
+    multi_tasking::BikeSystem bikeSystem;
+    Thread thread;
+    thread.start(callback(&bikeSystem, &multi_tasking::BikeSystem::start));
+    ThisThread::sleep_for(100ms);
+
+    // the restored distance only grows from the saved one
+    TEST_ASSERT_EQUAL_UINT8(gear, bikeSystem.getCurrentGear());
+    TEST_ASSERT_TRUE(bikeSystem.getSpeedometer().getDistance() >= distance);
+    TEST_ASSERT_TRUE(bikeSystem.getInitDuration() < coldInitDuration);
+    printf("Cold init %lld usecs, warm init %lld usecs\n",
+           coldInitDuration.count(),
+           bikeSystem.getInitDuration().count());
+
+    bikeSystem.stop();
+    thread.join();
+    bike_computer::RetainedRideState::getInstance().invalidate();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test retained ride state save and load", test_save_load),
+                       Case("test retained missed task", test_missed_task),
+                       Case("test bike system warm restart", test_warm_restart)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
@@ -53,6 +53,48 @@ static control_t test_sensor_device(const size_t call_count) {
     return CaseNext;
 }
 
+static volatile bool temperature_read_done = false;
+static void on_temperature_read() { temperature_read_done = true; }
+
+// test the temperature read run step by step on an event queue
+static control_t test_sensor_device_resumable_read(const size_t call_count) {
+    // create the SensorDevice instance
+    bike_computer::SensorDevice sensorDevice;
+
+    bool rc = sensorDevice.init();
+    TEST_ASSERT_TRUE(rc);
+
+    EventQueue eventQueue;
+    Thread thread;
+    thread.start(callback(&eventQueue, &EventQueue::dispatch_forever));
+    bike_computer::ResumableTask readTask(eventQueue, "TemperatureRead");
+    TEST_ASSERT_TRUE(readTask.start(
+        callback(&sensorDevice, &bike_computer::SensorDevice::readTemperatureStep),
+        on_temperature_read));
+    // a read still running cannot be started again
+    TEST_ASSERT_FALSE(readTask.start(
+        callback(&sensorDevice, &bike_computer::SensorDevice::readTemperatureStep),
+        on_temperature_read));
+    TEST_ASSERT_EQUAL_UINT32(1, readTask.getNbrOfOverruns());
+
+    ThisThread::sleep_for(50ms);
+    TEST_ASSERT_TRUE(temperature_read_done);
+    TEST_ASSERT_FALSE(readTask.isRunning());
+
+    // same result as the blocking read
+    static constexpr float kTemperatureDelta = 1.0f;
+    float lastTemperature                    = 0.0f;
+    TEST_ASSERT_TRUE(sensorDevice.getLastTemperature(lastTemperature));
+    TEST_ASSERT_FLOAT_WITHIN(
+        kTemperatureDelta, sensorDevice.readTemperature(), lastTemperature);
+
+    eventQueue.break_dispatch();
+    thread.join();
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
 static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
     // Here, we specify the timeout (60s) and the host test (a built-in host test or the
     // name of our Python file)
@@ -62,7 +104,9 @@ static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
 }
 
 // List of test cases in this file
-static Case cases[] = {Case("test sensor device", test_sensor_device)};
+static Case cases[] = {
+    Case("test sensor device", test_sensor_device),
+    Case("test sensor device resumable read", test_sensor_device_resumable_read)};
 
 static Specification specification(greentea_setup, cases);
 
@@ -22,7 +22,10 @@
  * @version 0.1.0
  ***************************************************************************/
 
+#include <cfloat>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 
 #include "common/constants.hpp"
 #include "common/speedometer.hpp"
@@ -334,6 +337,314 @@ static control_t test_reset(const size_t call_count) {
     return CaseNext;
 }
 
+// test the speedometer with a drivetrain profile loaded at runtime
+static control_t test_drivetrain_profile(const size_t call_count) {
+    // create a timer
+    Timer timer;
+    // start the timer
+    timer.start();
+
+    // create a speedometer instance
+    bike_computer::Speedometer speedometer(timer);
+
+    // an invalid profile (no cog) must be rejected
+    bike_computer::DrivetrainProfile profile = {2.2f, 2, {34, 50, 0}, 0, {0}};
+    TEST_ASSERT_FALSE(speedometer.setDrivetrainProfile(profile));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.1f, speedometer.getWheelCircumference());
+
+    // two chainrings and an 11 speed cassette
+    const uint8_t cassette[] = {32, 28, 25, 22, 20, 18, 16, 15, 14, 13, 12};
+    profile.nbrOfCogs        = sizeof(cassette);
+    memcpy(profile.cassette, cassette, sizeof(cassette));
+    TEST_ASSERT_TRUE(speedometer.setDrivetrainProfile(profile));
+    TEST_ASSERT_EQUAL(sizeof(cassette), speedometer.getDrivetrain().getNbrOfGears());
+
+    const auto pedalRotationTime = speedometer.getCurrentPedalRotationTime();
+    for (uint8_t chainring = 0; chainring < profile.nbrOfChainrings; chainring++) {
+        speedometer.setChainring(chainring);
+        for (uint8_t gear = 1; gear <= profile.nbrOfCogs; gear++) {
+            const uint8_t gearSize = speedometer.getDrivetrain().getCogSize(gear);
+            TEST_ASSERT_EQUAL(cassette[gear - 1], gearSize);
+            speedometer.setGearSize(gearSize);
+
+            // check the speed against the expected one
+            check_current_speed(pedalRotationTime,
+                                profile.chainrings[chainring],
+                                gearSize,
+                                profile.wheelCircumference,
+                                speedometer.getCurrentSpeed());
+        }
+    }
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that reading the distance does not modify the speedometer
+static control_t test_distance_readers(const size_t call_count) {
+    // create a timer
+    Timer timer;
+    // start the timer
+    timer.start();
+
+    // create a speedometer instance, read through a const reference only
+    bike_computer::Speedometer speedometer(timer);
+    const bike_computer::Speedometer& reader = speedometer;
+
+    // start riding
+    speedometer.setGearSize(bike_computer::kMaxGearSize);
+    const auto startTime = timer.elapsed_time();
+
+    // read the distance as fast as possible, as several tasks would do
+    float previousDistance = 0.0f;
+    uint32_t nbrOfReads    = 0;
+    while (timer.elapsed_time() - startTime < 1s) {
+        const float distance = reader.getDistance();
+        TEST_ASSERT_TRUE(distance >= previousDistance);
+        previousDistance = distance;
+        nbrOfReads++;
+    }
+    printf("  %" PRIu32 " distance reads\n", nbrOfReads);
+
+    // the distance must not depend on the number of reads
+    const float distance = reader.getDistance();
+    const auto travelTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(timer.elapsed_time() -
+                                                              startTime);
+    check_distance(speedometer.getCurrentPedalRotationTime(),
+                   speedometer.getTraySize(),
+                   speedometer.getGearSize(),
+                   speedometer.getWheelCircumference(),
+                   travelTime,
+                   distance);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// simulated time given to the speedometer, advanced by the fuzz test only
+struct SimulatedClock {
+    std::chrono::microseconds now = std::chrono::microseconds::zero();
+
+    std::chrono::microseconds getTime() const { return now; }
+};
+
+// double precision model of the speedometer: the speed only changes on gear,
+// chainring or rotation time changes and is zero after a reset, the distance is
+// integrated at the current speed
+struct ReferenceSpeedometer {
+    double wheelCircumference;
+    const uint8_t* chainrings;
+    uint8_t chainring;
+    uint8_t gearSize;
+    std::chrono::milliseconds pedalRotationTime;
+    double speed;
+    double distance;
+
+    double computeSpeed() const {
+        const double distancePerTurn = static_cast<double>(chainrings[chainring]) /
+                                       static_cast<double>(gearSize) *
+                                       wheelCircumference;
+        // m per turn and turns per hour give km / h
+        return distancePerTurn / 1000.0 * 3600000.0 /
+               static_cast<double>(pedalRotationTime.count());
+    }
+
+    void advance(const std::chrono::microseconds& elapsedTime) {
+        distance += speed * static_cast<double>(elapsedTime.count()) / 3.6e9;
+    }
+};
+
+// xorshift32, a fixed seed gives a reproducible sequence
+static uint32_t next_random(uint32_t& state) {  // NOLINT(runtime/references)
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// allow for 0.001 km/h and 1cm + one float ulp of the distance (the distance is
+// returned as a float) difference
+static constexpr float kAllowedFuzzSpeedDelta     = 0.001f;
+static constexpr double kAllowedFuzzDistanceDelta = 1.0 / 100000.0;
+// the distance errors are reported by band of 10 km, up to 100 km
+static constexpr double kFuzzBandDistance = 10.0;
+static constexpr uint8_t kNbrOfFuzzBands  = 10;
+static constexpr uint8_t kNbrOfRotationTimes =
+    (bike_computer::kMaxPedalRotationTime - bike_computer::kMinPedalRotationTime) /
+        bike_computer::kDeltaPedalRotationTime +
+    1;
+
+struct FuzzErrors {
+    float maxSpeedError;
+    double maxDistanceErrors[kNbrOfFuzzBands];
+};
+
+// drive a random sequence of gear, chainring and rotation time changes, resets (if
+// allowed) and time advances of up to maxTimeStep into the speedometer and compare
+// speed and distance with the reference model after each step. The sequence stops
+// after nbrOfSteps steps or when the reference distance reaches targetDistance
+static void run_fuzz_sequence(uint32_t seed,
+                              const bike_computer::DrivetrainProfile& profile,
+                              bool resetAllowed,
+                              uint32_t maxTimeStep,  // us
+                              uint32_t nbrOfSteps,
+                              double targetDistance,
+                              FuzzErrors& errors) {  // NOLINT(runtime/references)
+    Timer timer;
+    SimulatedClock clock;
+    bike_computer::Speedometer speedometer(timer);
+    speedometer.setTimeSource(callback(&clock, &SimulatedClock::getTime));
+    TEST_ASSERT_TRUE(speedometer.setDrivetrainProfile(profile));
+
+    ReferenceSpeedometer reference = {profile.wheelCircumference,
+                                      profile.chainrings,
+                                      0,
+                                      speedometer.getGearSize(),
+                                      speedometer.getCurrentPedalRotationTime(),
+                                      0.0,
+                                      0.0};
+    reference.speed                = reference.computeSpeed();
+
+    uint32_t randomState = seed;
+    for (uint32_t step = 0; step < nbrOfSteps && reference.distance < targetDistance;
+         step++) {
+        const uint32_t random = next_random(randomState);
+        switch (random % 8) {
+            case 0:
+            case 1: {
+                const uint8_t gearSize =
+                    bike_computer::kMinGearSize +
+                    (random >> 8) %
+                        (bike_computer::kMaxGearSize - bike_computer::kMinGearSize + 1);
+                speedometer.setGearSize(gearSize);
+                if (reference.gearSize != gearSize) {
+                    reference.gearSize = gearSize;
+                    reference.speed    = reference.computeSpeed();
+                }
+                break;
+            }
+            case 2:
+            case 3: {
+                const std::chrono::milliseconds pedalRotationTime =
+                    bike_computer::kMinPedalRotationTime +
+                    bike_computer::kDeltaPedalRotationTime *
+                        ((random >> 8) % kNbrOfRotationTimes);
+                speedometer.setCurrentRotationTime(pedalRotationTime);
+                if (reference.pedalRotationTime != pedalRotationTime) {
+                    reference.pedalRotationTime = pedalRotationTime;
+                    reference.speed             = reference.computeSpeed();
+                }
+                break;
+            }
+            case 4: {
+                const uint8_t chainring = (random >> 8) % profile.nbrOfChainrings;
+                speedometer.setChainring(chainring);
+                if (reference.chainring != chainring) {
+                    reference.chainring = chainring;
+                    reference.speed     = reference.computeSpeed();
+                }
+                break;
+            }
+            case 5:
+                // resets are rarer than the other inputs
+                if (resetAllowed && ((random >> 8) % 8) == 0) {
+                    speedometer.reset();
+                    reference.speed    = 0.0;
+                    reference.distance = 0.0;
+                }
+                break;
+            default:
+                break;
+        }
+
+        // time advances between inputs, sometimes not at all
+        const std::chrono::microseconds timeStep(next_random(randomState) %
+                                                 (maxTimeStep + 1));
+        clock.now += timeStep;
+        reference.advance(timeStep);
+
+        const float speedError =
+            fabsf(speedometer.getCurrentSpeed() - static_cast<float>(reference.speed));
+        const double distanceError =
+            fabs(static_cast<double>(speedometer.getDistance()) - reference.distance);
+        if (speedError > errors.maxSpeedError) {
+            errors.maxSpeedError = speedError;
+        }
+        uint8_t band = static_cast<uint8_t>(reference.distance / kFuzzBandDistance);
+        if (band >= kNbrOfFuzzBands) {
+            band = kNbrOfFuzzBands - 1;
+        }
+        if (distanceError > errors.maxDistanceErrors[band]) {
+            errors.maxDistanceErrors[band] = distanceError;
+        }
+        TEST_ASSERT_FLOAT_WITHIN(kAllowedFuzzSpeedDelta,
+                                 static_cast<float>(reference.speed),
+                                 speedometer.getCurrentSpeed());
+        TEST_ASSERT_FLOAT_WITHIN(static_cast<float>(kAllowedFuzzDistanceDelta +
+                                                    FLT_EPSILON * reference.distance),
+                                 static_cast<float>(reference.distance),
+                                 speedometer.getDistance());
+    }
+    // the long sequences must reach their distance
+    if (targetDistance < HUGE_VAL) {
+        TEST_ASSERT_TRUE(reference.distance >= targetDistance);
+    }
+}
+
+// short sequences with resets (the distance stays around 1 km) and long reset
+// free sequences (20 to 100 km), the distance errors are printed by band of
+// distance
+static control_t test_differential_fuzz(const size_t call_count) {
+    static constexpr uint32_t kNbrOfSteps = 5000;
+    // time advanced at each step, up to 2 s (short sequences) or 10 s (long
+    // sequences)
+    static constexpr uint32_t kMaxTimeStep     = 2000000;   // us
+    static constexpr uint32_t kMaxLongTimeStep = 10000000;  // us
+    static constexpr uint32_t kSeeds[]         = {0x2545F491, 0x9E3779B9, 0x1B873593};
+    // km
+    static constexpr double kLongDistances[] = {20.0, 50.0, 100.0};
+
+    // three chainrings, the default cassette
+    bike_computer::DrivetrainProfile profile =
+        bike_computer::Drivetrain::getDefaultProfile();
+    profile.nbrOfChainrings = 3;
+    profile.chainrings[0]   = 50;
+    profile.chainrings[1]   = 39;
+    profile.chainrings[2]   = 30;
+
+    FuzzErrors errors = {};
+    for (uint32_t seed : kSeeds) {
+        printf("Testing seed 0x%08" PRIx32 "\n", seed);
+        run_fuzz_sequence(
+            seed, profile, true, kMaxTimeStep, kNbrOfSteps, HUGE_VAL, errors);
+    }
+    // one seed per long distance
+    const uint32_t* seed = kSeeds;
+    for (double longDistance : kLongDistances) {
+        printf("Testing seed 0x%08" PRIx32 " without reset over %" PRIu32 " km\n",
+               *seed,
+               static_cast<uint32_t>(longDistance));
+        run_fuzz_sequence(
+            *seed, profile, false, kMaxLongTimeStep, UINT32_MAX, longDistance, errors);
+        seed++;
+    }
+
+    // minimal-printf prints 2 decimals only: the errors are printed in um/h and um
+    printf("  Max speed error is %" PRIu32 " um/h\n",
+           static_cast<uint32_t>(errors.maxSpeedError * 1.0e9f + 0.5f));
+    for (uint8_t band = 0; band < kNbrOfFuzzBands; band++) {
+        printf("  Max distance error from %" PRIu32 " to %" PRIu32 " km is %" PRIu32
+               " um\n",
+               static_cast<uint32_t>(band * kFuzzBandDistance),
+               static_cast<uint32_t>((band + 1) * kFuzzBandDistance),
+               static_cast<uint32_t>(errors.maxDistanceErrors[band] * 1.0e9 + 0.5));
+    }
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
 static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
     // Here, we specify the timeout (60s) and the host test (a built-in host test or the
     // name of our Python file)
@@ -347,7 +658,10 @@ static Case cases[] = {
     Case("test speedometer gear size change", test_gear_size),
     Case("test speedometer rotation speed change", test_rotation_speed),
     Case("test speedometer distance", test_distance),
-    Case("test speedometer reset", test_reset)};
+    Case("test speedometer reset", test_reset),
+    Case("test speedometer drivetrain profile", test_drivetrain_profile),
+    Case("test speedometer distance readers", test_distance_readers),
+    Case("test speedometer differential fuzz", test_differential_fuzz)};
 
 static Specification specification(greentea_setup, cases);
 
@@ -0,0 +1,190 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: task heartbeats and watchdog supervision
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <chrono>
+#include <cstring>
+
+#include "common/task_supervisor.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+static constexpr std::chrono::milliseconds kWatchdogTimeout = 300ms;
+static constexpr std::chrono::milliseconds kStep            = 50ms;
+
+// runs the fast task every 2 steps and the slow task every 6 steps (if
+// enabled), the heartbeats are checked at each step
+static void run_tasks(bike_computer::TaskSupervisor& taskSupervisor,
+                      bike_computer::TaskSupervisor::HeartbeatId fastId,
+                      bike_computer::TaskSupervisor::HeartbeatId slowId,
+                      bool slowTaskAlive,
+                      uint8_t nbrOfSteps) {
+    for (uint8_t step = 1; step <= nbrOfSteps; step++) {
+        ThisThread::sleep_for(kStep);
+        if (step % 2 == 0) {
+            taskSupervisor.heartbeat(fastId);
+        }
+        if (slowTaskAlive && step % 6 == 0) {
+            taskSupervisor.heartbeat(slowId);
+        }
+        taskSupervisor.check();
+    }
+}
+
+// test that the watchdog is kicked while all heartbeats are fresh
+static control_t test_fresh_heartbeats(const size_t call_count) {
+    Timer timer;
+    timer.start();
+    bike_computer::SimulatedWatchdog watchdog(timer);
+    bike_computer::TaskSupervisor taskSupervisor(timer, watchdog, kWatchdogTimeout);
+    const bike_computer::TaskSupervisor::HeartbeatId fastId =
+        taskSupervisor.registerTask("Fast", 100ms, 50ms);
+    const bike_computer::TaskSupervisor::HeartbeatId slowId =
+        taskSupervisor.registerTask("Slow", 300ms, 125ms);
+    TEST_ASSERT_NOT_EQUAL(bike_computer::TaskSupervisor::kInvalidHeartbeatId, fastId);
+    TEST_ASSERT_NOT_EQUAL(bike_computer::TaskSupervisor::kInvalidHeartbeatId, slowId);
+    TEST_ASSERT_TRUE(taskSupervisor.start());
+
+    run_tasks(taskSupervisor, fastId, slowId, true, 24);
+    TEST_ASSERT_FALSE(watchdog.isExpired());
+    TEST_ASSERT_EQUAL_UINT32(24, watchdog.getNbrOfKicks());
+    TEST_ASSERT_NULL(taskSupervisor.getMissedTask());
+
+    // the statistics give the measured intervals, to be compared with the budget
+    bike_computer::HeartbeatStats stats;
+    TEST_ASSERT_TRUE(taskSupervisor.getStats(fastId, stats));
+    TEST_ASSERT_EQUAL_UINT32(12, stats.nbrOfBeats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.nbrOfMisses);
+    TEST_ASSERT_UINT32_WITHIN(5000, 100000, stats.maxInterval.count());
+    TEST_ASSERT_EQUAL_UINT32(150000, stats.budget.count());
+    TEST_ASSERT_TRUE(taskSupervisor.getStats(slowId, stats));
+    TEST_ASSERT_EQUAL_UINT32(4, stats.nbrOfBeats);
+    TEST_ASSERT_UINT32_WITHIN(5000, 300000, stats.maxInterval.count());
+    TEST_ASSERT_FALSE(taskSupervisor.getStats(slowId + 1, stats));
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a missed heartbeat stops the kicks and is recorded
+static control_t test_missed_heartbeat(const size_t call_count) {
+    Timer timer;
+    timer.start();
+    bike_computer::SimulatedWatchdog watchdog(timer);
+    bike_computer::TaskSupervisor taskSupervisor(timer, watchdog, kWatchdogTimeout);
+    const bike_computer::TaskSupervisor::HeartbeatId fastId =
+        taskSupervisor.registerTask("Fast", 100ms, 50ms);
+    const bike_computer::TaskSupervisor::HeartbeatId slowId =
+        taskSupervisor.registerTask("Slow", 300ms, 125ms);
+    TEST_ASSERT_TRUE(taskSupervisor.start());
+    run_tasks(taskSupervisor, fastId, slowId, true, 12);
+
+    // the slow task stops after its heartbeat of step 12: the budget (425 ms)
+    // is exceeded 9 steps later, then the watchdog expires 300 ms after the
+    // last kick
+    run_tasks(taskSupervisor, fastId, slowId, false, 7);
+    TEST_ASSERT_FALSE(watchdog.isExpired());
+    TEST_ASSERT_NULL(taskSupervisor.getMissedTask());
+    const uint32_t nbrOfKicks = watchdog.getNbrOfKicks();
+    run_tasks(taskSupervisor, fastId, slowId, false, 8);
+    TEST_ASSERT_TRUE(watchdog.isExpired());
+    TEST_ASSERT_UINT32_WITHIN(1, 1, watchdog.getNbrOfKicks() - nbrOfKicks);
+    TEST_ASSERT_NOT_NULL(taskSupervisor.getMissedTask());
+    TEST_ASSERT_EQUAL_STRING("Slow", taskSupervisor.getMissedTask());
+
+    // a miss is counted once, the other task is not affected
+    bike_computer::HeartbeatStats stats;
+    TEST_ASSERT_TRUE(taskSupervisor.getStats(slowId, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.nbrOfMisses);
+    TEST_ASSERT_TRUE(taskSupervisor.getStats(fastId, stats));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.nbrOfMisses);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that the missed task follows the stale task and is cleared on recovery
+static control_t test_recovered_heartbeat(const size_t call_count) {
+    Timer timer;
+    timer.start();
+    bike_computer::SimulatedWatchdog watchdog(timer);
+    bike_computer::TaskSupervisor taskSupervisor(timer, watchdog, kWatchdogTimeout);
+    const bike_computer::TaskSupervisor::HeartbeatId fastId =
+        taskSupervisor.registerTask("Fast", 100ms, 50ms);
+    const bike_computer::TaskSupervisor::HeartbeatId slowId =
+        taskSupervisor.registerTask("Slow", 300ms, 125ms);
+    TEST_ASSERT_TRUE(taskSupervisor.start());
+    run_tasks(taskSupervisor, fastId, slowId, true, 12);
+
+    // the slow task misses its heartbeat at the 9th step, before the watchdog
+    // expires
+    run_tasks(taskSupervisor, fastId, slowId, false, 10);
+    TEST_ASSERT_FALSE(watchdog.isExpired());
+    TEST_ASSERT_EQUAL_STRING("Slow", taskSupervisor.getMissedTask());
+
+    // the slow task recovers: the watchdog is kicked and nothing is reported
+    const uint32_t nbrOfKicks = watchdog.getNbrOfKicks();
+    taskSupervisor.heartbeat(fastId);
+    taskSupervisor.heartbeat(slowId);
+    taskSupervisor.check();
+    TEST_ASSERT_EQUAL_UINT32(nbrOfKicks + 1, watchdog.getNbrOfKicks());
+    TEST_ASSERT_NULL(taskSupervisor.getMissedTask());
+
+    // then the fast task stops (budget 150 ms), it is the one reported
+    for (uint8_t step = 1; step <= 4; step++) {
+        ThisThread::sleep_for(kStep);
+        taskSupervisor.heartbeat(slowId);
+        taskSupervisor.check();
+    }
+    TEST_ASSERT_EQUAL_STRING("Fast", taskSupervisor.getMissedTask());
+
+    bike_computer::HeartbeatStats stats;
+    TEST_ASSERT_TRUE(taskSupervisor.getStats(slowId, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.nbrOfMisses);
+    TEST_ASSERT_TRUE(taskSupervisor.getStats(fastId, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.nbrOfMisses);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test fresh heartbeats", test_fresh_heartbeats),
+                       Case("test missed heartbeat", test_missed_heartbeat),
+                       Case("test recovered heartbeat", test_recovered_heartbeat)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
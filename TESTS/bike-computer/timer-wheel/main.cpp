@@ -0,0 +1,262 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: timer wheel
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <chrono>
+
+#include "common/timer_wheel.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+static constexpr std::chrono::milliseconds kTickPeriod = 10ms;
+
+// counts the runs of a timer and the tick of its last run
+struct TimerCounter {
+    bike_computer::TimerWheel* timerWheel;
+    uint32_t nbrOfRuns;
+    uint32_t lastTick;
+
+    void onTimer() {
+        nbrOfRuns++;
+        lastTick = timerWheel->getCurrentTick();
+    }
+};
+
+// adds two timers when it runs
+struct TimerAdder {
+    TimerCounter counter;
+    TimerCounter* lateAligned;
+    TimerCounter* relative;
+
+    void onTimer() {
+        bike_computer::TimerWheel& timerWheel = *counter.timerWheel;
+        timerWheel.addTimer("LateAligned",
+                            callback(lateAligned, &TimerCounter::onTimer),
+                            200ms,
+                            50ms,
+                            bike_computer::TimerAlignment::Absolute);
+        timerWheel.addTimer(
+            "Relative", callback(relative, &TimerCounter::onTimer), 200ms, 50ms);
+        counter.onTimer();
+    }
+};
+
+// removes its own timer at its third run
+struct SelfRemover {
+    bike_computer::TimerWheel* timerWheel;
+    bike_computer::TimerWheel::TimerId timerId;
+    uint32_t nbrOfRuns;
+
+    void onTimer() {
+        nbrOfRuns++;
+        if (nbrOfRuns == 3) {
+            timerWheel->removeTimer(timerId);
+        }
+    }
+};
+
+// dispatch the queue of the timer wheel on its own thread for duration
+static void run_timer_wheel(EventQueue& eventQueue,  // NOLINT(runtime/references)
+                            bike_computer::TimerWheel& timerWheel,  // NOLINT
+                            const std::chrono::milliseconds& duration) {
+    Thread thread(osPriorityAboveNormal, OS_STACK_SIZE, nullptr, "TimerWheel");
+    TEST_ASSERT_TRUE(timerWheel.start());
+    thread.start(callback(&eventQueue, &EventQueue::dispatch_forever));
+    ThisThread::sleep_for(duration);
+    timerWheel.stop();
+    eventQueue.break_dispatch();
+    thread.join();
+}
+
+// test the number of runs of timers with different periods, including one
+// longer than the first level of the wheel
+static control_t test_periods(const size_t call_count) {
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, kTickPeriod);
+
+    static constexpr uint8_t kNbrOfTimers                     = 4;
+    const std::chrono::milliseconds periods[kNbrOfTimers]     = {20ms, 50ms, 300ms, 1s};
+    TimerCounter counters[kNbrOfTimers]                       = {};
+    bike_computer::TimerWheel::TimerId timerIds[kNbrOfTimers] = {};
+    for (uint8_t index = 0; index < kNbrOfTimers; index++) {
+        counters[index].timerWheel = &timerWheel;
+        timerIds[index]            = timerWheel.addTimer(
+            "Test",
+            callback(&counters[index], &TimerCounter::onTimer),
+            periods[index],
+            0ms);
+        TEST_ASSERT_NOT_EQUAL(bike_computer::TimerWheel::kInvalidTimerId,
+                              timerIds[index]);
+    }
+
+    // run for 2.5 s, the first run is at tick 0
+    static constexpr std::chrono::milliseconds kRunDuration = 2505ms;
+    run_timer_wheel(eventQueue, timerWheel, kRunDuration);
+
+    for (uint8_t index = 0; index < kNbrOfTimers; index++) {
+        const uint32_t expectedRuns = kRunDuration / periods[index] + 1;
+        bike_computer::TimerStats stats;
+        TEST_ASSERT_TRUE(timerWheel.getStats(timerIds[index], stats));
+        printf("  period %d ms: %" PRIu32 " runs, lateness max %" PRIu32 " us\n",
+               static_cast<int>(periods[index].count()),
+               stats.nbrOfRuns,
+               static_cast<uint32_t>(stats.maxLateness.count()));
+        TEST_ASSERT_UINT32_WITHIN(1, expectedRuns, counters[index].nbrOfRuns);
+        TEST_ASSERT_EQUAL_UINT32(counters[index].nbrOfRuns, stats.nbrOfRuns);
+        // the queue is otherwise idle, runs are never late by a full tick
+        TEST_ASSERT_TRUE(stats.maxLateness < kTickPeriod);
+    }
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a period shorter than one tick runs every tick instead of making a
+// one-shot timer
+static control_t test_sub_tick_period(const size_t call_count) {
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, kTickPeriod);
+
+    TimerCounter fastCounter                      = {&timerWheel, 0, 0};
+    TimerCounter changedCounter                   = {&timerWheel, 0, 0};
+    const bike_computer::TimerWheel::TimerId fast = timerWheel.addTimer(
+        "Fast", callback(&fastCounter, &TimerCounter::onTimer), 5ms, 0ms);
+    const bike_computer::TimerWheel::TimerId changed = timerWheel.addTimer(
+        "Changed", callback(&changedCounter, &TimerCounter::onTimer), 100ms, 0ms);
+    TEST_ASSERT_NOT_EQUAL(bike_computer::TimerWheel::kInvalidTimerId, fast);
+    TEST_ASSERT_NOT_EQUAL(bike_computer::TimerWheel::kInvalidTimerId, changed);
+    TEST_ASSERT_TRUE(timerWheel.setPeriod(changed, 1ms));
+    TEST_ASSERT_FALSE(timerWheel.setPeriod(changed, 0ms));
+
+    // run for 0.5 s, the first run is at tick 0
+    static constexpr std::chrono::milliseconds kRunDuration = 505ms;
+    run_timer_wheel(eventQueue, timerWheel, kRunDuration);
+
+    const uint32_t expectedRuns = kRunDuration / kTickPeriod + 1;
+    TEST_ASSERT_UINT32_WITHIN(1, expectedRuns, fastCounter.nbrOfRuns);
+    TEST_ASSERT_UINT32_WITHIN(1, expectedRuns, changedCounter.nbrOfRuns);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that absolute timers added at different times run in the same tick and
+// that relative ones keep their offset
+static control_t test_alignment(const size_t call_count) {
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, kTickPeriod);
+
+    TimerCounter aligned     = {&timerWheel, 0, 0};
+    TimerCounter lateAligned = {&timerWheel, 0, 0};
+    TimerCounter relative    = {&timerWheel, 0, 0};
+    timerWheel.addTimer("Aligned",
+                        callback(&aligned, &TimerCounter::onTimer),
+                        200ms,
+                        50ms,
+                        bike_computer::TimerAlignment::Absolute);
+
+    // add the other timers from the wheel itself, after 130 ms
+    TimerAdder adder = {{&timerWheel, 0, 0}, &lateAligned, &relative};
+    timerWheel.addTimer("Adder", callback(&adder, &TimerAdder::onTimer), 0ms, 130ms);
+
+    run_timer_wheel(eventQueue, timerWheel, 1000ms);
+
+    TEST_ASSERT_EQUAL_UINT32(1, adder.counter.nbrOfRuns);
+    TEST_ASSERT_EQUAL_UINT32(13, adder.counter.lastTick);
+    // runs at 50, 250, 450, 650 and 850 ms
+    TEST_ASSERT_EQUAL_UINT32(5, aligned.nbrOfRuns);
+    TEST_ASSERT_EQUAL_UINT32(85, aligned.lastTick);
+    // runs at 250, 450, 650 and 850 ms
+    TEST_ASSERT_EQUAL_UINT32(4, lateAligned.nbrOfRuns);
+    TEST_ASSERT_EQUAL_UINT32(aligned.lastTick, lateAligned.lastTick);
+    // runs at 190, 390, 590, 790 and 990 ms
+    TEST_ASSERT_EQUAL_UINT32(5, relative.nbrOfRuns);
+    TEST_ASSERT_EQUAL_UINT32(99, relative.lastTick);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that all timers may be used and removed, also from their own callback
+static control_t test_many_timers(const size_t call_count) {
+    EventQueue eventQueue;
+    bike_computer::TimerWheel timerWheel(eventQueue, kTickPeriod);
+
+    static constexpr uint8_t kNbrOfTimers = bike_computer::TimerWheel::kMaxTimers;
+    TimerCounter counters[kNbrOfTimers]   = {};
+    for (uint8_t index = 0; index < kNbrOfTimers; index++) {
+        counters[index].timerWheel = &timerWheel;
+        // periods from 10 ms to 320 ms, with different phases
+        TEST_ASSERT_NOT_EQUAL(
+            bike_computer::TimerWheel::kInvalidTimerId,
+            timerWheel.addTimer("Test",
+                                callback(&counters[index], &TimerCounter::onTimer),
+                                (index + 1) * kTickPeriod,
+                                (index % 7) * kTickPeriod));
+    }
+    TEST_ASSERT_EQUAL(
+        bike_computer::TimerWheel::kInvalidTimerId,
+        timerWheel.addTimer(
+            "Extra", callback(&counters[0], &TimerCounter::onTimer), 10ms, 0ms));
+
+    // a timer removing itself frees its slot
+    TEST_ASSERT_TRUE(timerWheel.removeTimer(kNbrOfTimers - 1));
+    TEST_ASSERT_FALSE(timerWheel.removeTimer(kNbrOfTimers - 1));
+    SelfRemover selfRemover = {&timerWheel, 0, 0};
+    selfRemover.timerId     = timerWheel.addTimer(
+        "Self", callback(&selfRemover, &SelfRemover::onTimer), 10ms, 0ms);
+    TEST_ASSERT_EQUAL(kNbrOfTimers - 1, selfRemover.timerId);
+
+    run_timer_wheel(eventQueue, timerWheel, 1000ms);
+
+    TEST_ASSERT_EQUAL_UINT32(3, selfRemover.nbrOfRuns);
+    for (uint8_t index = 0; index < kNbrOfTimers - 1; index++) {
+        TEST_ASSERT_TRUE(counters[index].nbrOfRuns > 0);
+    }
+    printf("  up to %" PRIu32 " ticks per event\n", timerWheel.getMaxTicksPerEvent());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {Case("test timer wheel periods", test_periods),
+                       Case("test timer wheel sub-tick period", test_sub_tick_period),
+                       Case("test timer wheel alignment", test_alignment),
+                       Case("test timer wheel many timers", test_many_timers)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
@@ -0,0 +1,180 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file main.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Bike computer test suite: trip statistics
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include <chrono>
+
+#include "common/constants.hpp"
+#include "common/trip_statistics.hpp"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+// allow for 0.1 km/h difference
+static constexpr float kAllowedSpeedDelta = 0.1f;
+// allow for 1m difference
+static constexpr float kAllowedDistanceDelta = 1.0f / 1000.0;
+
+// the statistics are computed from the event timestamps only, the tests use
+// synthetic times and run instantly
+
+// test the average and the max speed over a trip made of several segments
+static control_t test_average_and_max_speed(const size_t call_count) {
+    bike_computer::TripStatistics tripStatistics;
+
+    // 10 min at 20 km/h, then 5 min at 40 km/h, then 15 min at 10 km/h
+    tripStatistics.onPedalRotationChanged(
+        0s, 20.0f, bike_computer::kInitialPedalRotationTime);
+    tripStatistics.onGearChanged(10min, 40.0f);
+    tripStatistics.onGearChanged(15min, 10.0f);
+
+    bike_computer::TripSnapshot snapshot;
+    tripStatistics.getSnapshot(30min, snapshot);
+
+    // (20 * 10 + 40 * 5 + 10 * 15) / 30 km/h
+    const float expectedDistance = (20.0f * 10.0f + 40.0f * 5.0f + 10.0f * 15.0f) / 60.0f;
+    printf("  Expected distance is %f, moving distance is %f\n",
+           expectedDistance,
+           snapshot.movingDistance);
+    TEST_ASSERT_FLOAT_WITHIN(
+        kAllowedDistanceDelta, expectedDistance, snapshot.movingDistance);
+    printf("  Expected average is %f, average is %f\n",
+           expectedDistance * 2.0f,
+           snapshot.averageSpeed);
+    TEST_ASSERT_FLOAT_WITHIN(
+        kAllowedSpeedDelta, expectedDistance * 2.0f, snapshot.averageSpeed);
+    TEST_ASSERT_FLOAT_WITHIN(kAllowedSpeedDelta, 40.0f, snapshot.maxSpeed);
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(30min).count(),
+                      snapshot.movingTime.count());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that the time spent stopped is not accounted as moving time
+static control_t test_moving_time(const size_t call_count) {
+    bike_computer::TripStatistics tripStatistics;
+
+    // 2 min stopped, 3 min riding, 4 min stopped
+    tripStatistics.onGearChanged(2min, 30.0f);
+    tripStatistics.onGearChanged(5min, 0.0f);
+
+    bike_computer::TripSnapshot snapshot;
+    tripStatistics.getSnapshot(9min, snapshot);
+
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(3min).count(),
+                      snapshot.movingTime.count());
+    TEST_ASSERT_FLOAT_WITHIN(kAllowedSpeedDelta, 30.0f, snapshot.averageSpeed);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test the time spent in each speed and cadence zone
+static control_t test_time_in_zone(const size_t call_count) {
+    bike_computer::TripStatistics tripStatistics;
+
+    const uint8_t slowZone = bike_computer::TripStatistics::getSpeedZone(10.0f);
+    const uint8_t fastZone = bike_computer::TripStatistics::getSpeedZone(40.0f);
+    const uint8_t lowCadenceZone =
+        bike_computer::TripStatistics::getCadenceZone(
+            bike_computer::kMaxPedalRotationTime);
+    const uint8_t highCadenceZone =
+        bike_computer::TripStatistics::getCadenceZone(
+            bike_computer::kMinPedalRotationTime);
+    TEST_ASSERT_NOT_EQUAL(slowZone, fastZone);
+    TEST_ASSERT_NOT_EQUAL(lowCadenceZone, highCadenceZone);
+
+    // 1 min slow with a low cadence, 2 min fast with a high cadence
+    tripStatistics.onPedalRotationChanged(
+        0s, 10.0f, bike_computer::kMaxPedalRotationTime);
+    tripStatistics.onPedalRotationChanged(
+        1min, 40.0f, bike_computer::kMinPedalRotationTime);
+
+    bike_computer::TripSnapshot snapshot;
+    tripStatistics.getSnapshot(3min, snapshot);
+
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(1min).count(),
+                      snapshot.timeInSpeedZone[slowZone].count());
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(2min).count(),
+                      snapshot.timeInSpeedZone[fastZone].count());
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(1min).count(),
+                      snapshot.timeInCadenceZone[lowCadenceZone].count());
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(2min).count(),
+                      snapshot.timeInCadenceZone[highCadenceZone].count());
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+// test that a snapshot does not modify the statistics and that reset clears them
+static control_t test_snapshot_and_reset(const size_t call_count) {
+    bike_computer::TripStatistics tripStatistics;
+
+    tripStatistics.onGearChanged(0s, 30.0f);
+
+    // taking snapshots must not change the statistics
+    bike_computer::TripSnapshot snapshot;
+    tripStatistics.getSnapshot(5min, snapshot);
+    tripStatistics.getSnapshot(10min, snapshot);
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(10min).count(),
+                      snapshot.movingTime.count());
+
+    tripStatistics.reset(10min);
+    tripStatistics.getSnapshot(20min, snapshot);
+    TEST_ASSERT_EQUAL(0, snapshot.movingTime.count());
+    TEST_ASSERT_FLOAT_WITHIN(kAllowedSpeedDelta, 0.0f, snapshot.maxSpeed);
+    TEST_ASSERT_FLOAT_WITHIN(kAllowedDistanceDelta, 0.0f, snapshot.movingDistance);
+
+    // statistics restart with the next event
+    tripStatistics.onGearChanged(20min, 20.0f);
+    tripStatistics.getSnapshot(21min, snapshot);
+    TEST_ASSERT_EQUAL(std::chrono::milliseconds(1min).count(),
+                      snapshot.movingTime.count());
+    TEST_ASSERT_FLOAT_WITHIN(kAllowedSpeedDelta, 20.0f, snapshot.maxSpeed);
+
+    // execute the test only once and move to the next one, without waiting
+    return CaseNext;
+}
+
+static utest::v1::status_t greentea_setup(const size_t number_of_cases) {
+    // Here, we specify the timeout (60s) and the host test (a built-in host test or the
+    // name of our Python file)
+    GREENTEA_SETUP(60, "default_auto");
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+// List of test cases in this file
+static Case cases[] = {
+    Case("test trip statistics average and max speed", test_average_and_max_speed),
+    Case("test trip statistics moving time", test_moving_time),
+    Case("test trip statistics time in zone", test_time_in_zone),
+    Case("test trip statistics snapshot and reset", test_snapshot_and_reset)};
+
+static Specification specification(greentea_setup, cases);
+
+int main() { return !Harness::run(specification); }
@@ -0,0 +1,121 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file application_header.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Header-only access to application metadata (bootloader)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "application_header.hpp"
+
+#include <cstring>
+
+#include "MbedCRC.h"
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "bootloader"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bootloader {
+
+// magic value defined in mbed_lib.json
+static constexpr uint32_t kHeaderMagic = 0x5a51b3d4;
+
+// offsets of the fields in the header, all fields are stored big endian
+static constexpr uint32_t kMagicOffset           = 0;
+static constexpr uint32_t kHeaderVersionOffset   = 4;
+static constexpr uint32_t kFirmwareVersionOffset = 8;
+static constexpr uint32_t kFirmwareSizeOffset    = 16;
+static constexpr uint32_t kHashOffset            = 24;
+static constexpr uint32_t kSignatureSizeOffset   = 104;
+static constexpr uint32_t kHeaderCRCOffset       = 108;
+
+static uint32_t parseUint32(const uint8_t* buffer) {
+    return (static_cast<uint32_t>(buffer[0]) << 24) |
+           (static_cast<uint32_t>(buffer[1]) << 16) |
+           (static_cast<uint32_t>(buffer[2]) << 8) | static_cast<uint32_t>(buffer[3]);
+}
+
+static uint64_t parseUint64(const uint8_t* buffer) {
+    return (static_cast<uint64_t>(parseUint32(buffer)) << 32) |
+           static_cast<uint64_t>(parseUint32(buffer + 4));
+}
+
+bool readApplicationHeader(mbed::BlockDevice& blockDevice,
+                           mbed::bd_addr_t headerAddress,
+                           ApplicationHeader& header) {
+    uint8_t buffer[kApplicationHeaderSize] = {0};
+    int rc = blockDevice.read(buffer, headerAddress, kApplicationHeaderSize);
+    if (rc != 0) {
+        tr_error("Cannot read header at address 0x%08x: %d",
+                 static_cast<uint32_t>(headerAddress),
+                 rc);
+        return false;
+    }
+
+    header.magic = parseUint32(buffer + kMagicOffset);
+    if (header.magic != kHeaderMagic) {
+        tr_debug("Invalid magic 0x%08x at address 0x%08x",
+                 header.magic,
+                 static_cast<uint32_t>(headerAddress));
+        return false;
+    }
+    header.headerVersion   = parseUint32(buffer + kHeaderVersionOffset);
+    header.firmwareVersion = parseUint64(buffer + kFirmwareVersionOffset);
+    header.firmwareSize    = parseUint64(buffer + kFirmwareSizeOffset);
+    memcpy(header.hash, buffer + kHashOffset, sizeof(header.hash));
+    header.signatureSize = parseUint32(buffer + kSignatureSizeOffset);
+    header.headerCRC     = parseUint32(buffer + kHeaderCRCOffset);
+
+    // the crc covers all bytes preceding it
+    mbed::MbedCRC<POLY_32BIT_ANSI, 32> crc;
+    uint32_t computedCRC = 0;
+    crc.compute(buffer, kHeaderCRCOffset, &computedCRC);
+    if (computedCRC != header.headerCRC) {
+        tr_debug("Invalid header crc 0x%08x (expected 0x%08x)",
+                 computedCRC,
+                 header.headerCRC);
+        return false;
+    }
+
+    return true;
+}
+
+HeaderComparison compareHeaders(const ApplicationHeader& active,
+                                const ApplicationHeader& candidate) {
+    HeaderComparison comparison;
+    comparison.sameVersion = active.firmwareVersion == candidate.firmwareVersion;
+    comparison.newer       = candidate.firmwareVersion > active.firmwareVersion;
+    comparison.sameSize    = active.firmwareSize == candidate.firmwareSize;
+    comparison.sameDigest =
+        memcmp(active.hash, candidate.hash, sizeof(active.hash)) == 0;
+    return comparison;
+}
+
+void printComparison(const HeaderComparison& comparison) {
+    tr_debug("Candidate version is %s",
+             comparison.sameVersion ? "identical"
+                                    : (comparison.newer ? "newer" : "older"));
+    tr_debug("Candidate size is %s", comparison.sameSize ? "identical" : "different");
+    tr_debug("Candidate digest is %s",
+             comparison.sameDigest ? "identical" : "different");
+}
+
+}  // namespace bootloader
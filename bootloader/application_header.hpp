@@ -0,0 +1,66 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file application_header.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Header-only access to application metadata (bootloader)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "BlockDevice.h"
+#include "mbed.h"
+
+namespace bootloader {
+
+// application header as described by "target.header_format" in mbed_lib.json
+struct ApplicationHeader {
+    uint32_t magic;
+    uint32_t headerVersion;
+    uint64_t firmwareVersion;
+    uint64_t firmwareSize;
+    uint8_t hash[32];
+    uint32_t signatureSize;
+    uint32_t headerCRC;
+};
+
+// result of a header-only comparison of two applications
+struct HeaderComparison {
+    bool sameVersion;
+    bool newer;
+    bool sameSize;
+    bool sameDigest;
+};
+
+// size of the header as stored in flash (fields, padding and crc)
+static constexpr uint32_t kApplicationHeaderSize = 112;
+
+// read and validate (magic and crc) the header stored at headerAddress
+bool readApplicationHeader(mbed::BlockDevice& blockDevice,
+                           mbed::bd_addr_t headerAddress,
+                           ApplicationHeader& header);  // NOLINT(runtime/references)
+
+// compare versions, sizes and digests, without reading the applications
+HeaderComparison compareHeaders(const ApplicationHeader& active,
+                                const ApplicationHeader& candidate);
+
+// log the result of a comparison
+void printComparison(const HeaderComparison& comparison);
+
+}  // namespace bootloader
@@ -0,0 +1,46 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file boot_timeline.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Timing breakdown of the bootloader phases
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "boot_timeline.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "bootloader"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bootloader {
+
+void BootTimeline::print() const {
+    static const char* const kPhaseNames[NbrOfPhases] = {
+        "init", "check", "scan slots", "compare", "install", "jump"};
+    for (uint8_t phase = 0; phase < NbrOfPhases; phase++) {
+        tr_debug("Boot phase %s: %" PRIu64 " usecs",
+                 kPhaseNames[phase],
+                 _phaseDurations[phase].count());
+    }
+    tr_debug("Boot total: %" PRIu64 " usecs", _lastTime.count());
+}
+
+}  // namespace bootloader
@@ -0,0 +1,67 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file boot_timeline.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Timing breakdown of the bootloader phases
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bootloader {
+
+class BootTimeline {
+   public:
+    enum Phase : uint8_t {
+        Init = 0,
+        Check,
+        ScanSlots,
+        Compare,
+        Install,
+        Jump,
+        NbrOfPhases
+    };
+
+    BootTimeline() { _timer.start(); }
+
+    // make the class non copyable
+    BootTimeline(BootTimeline&)            = delete;
+    BootTimeline& operator=(BootTimeline&) = delete;
+
+    // called at the end of a phase, the phase lasts since the previous call
+    void endPhase(Phase phase) {
+        std::chrono::microseconds now = _timer.elapsed_time();
+        _phaseDurations[phase]        = now - _lastTime;
+        _lastTime                     = now;
+    }
+
+    // print the duration of each phase (phases not run are printed as 0)
+    void print() const;
+
+   private:
+    Timer _timer;
+    std::chrono::microseconds _lastTime = std::chrono::microseconds::zero();
+    std::chrono::microseconds _phaseDurations[NbrOfPhases] = {};
+};
+
+}  // namespace bootloader
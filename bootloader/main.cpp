@@ -2,6 +2,8 @@
 #include "mbed.h"
 #include "BlockDevice.h"
 #include "mbed_trace.h"
+#include "application_header.hpp"
+#include "boot_timeline.hpp"
 #include "update-client/block_device_application.hpp"
 #include "update-client/uc_error_code.hpp"
 #include "update-client/usb_serial_uc.hpp"
@@ -27,6 +29,7 @@ static void boot_debug(const char *s)
 
 int main()
 {
+    bootloader::BootTimeline bootTimeline;
 #if MBED_CONF_MBED_TRACE_ENABLE
     mbed_trace_init();
     mbed_trace_print_function_set(boot_debug);
@@ -35,7 +38,9 @@ int main()
 
     FlashIAPBlockDevice flashIAPBlockDevice(MBED_ROM_START, MBED_ROM_SIZE);
 
-    if(flashIAPBlockDevice.init() == 0){
+    int initRC = flashIAPBlockDevice.init();
+    bootTimeline.endPhase(bootloader::BootTimeline::Init);
+    if(initRC == 0){
         mbed::bd_addr_t headerAddress = HEADER_ADDR - MBED_ROM_START; //Starting relative to ROM_START
         mbed::bd_addr_t applicationAddress = POST_APPLICATION_ADDR - MBED_ROM_START;
         update_client::BlockDeviceApplication activeApplciation(
@@ -51,6 +56,7 @@ int main()
         else {
             tr_debug("Active application is valid");
         }
+        bootTimeline.endPhase(bootloader::BootTimeline::Check);
 
 
         //Used for installing on reboot
@@ -62,11 +68,28 @@ int main()
         update_client::CandidateApplications candidateApplications(flashIAPBlockDevice, storage_address, storage_size, header_size, nbr_of_slots); 
 
         uint32_t new_slot_index = 0;
-        if(candidateApplications.hasValidNewerApplication(activeApplciation, new_slot_index)){
+        bool hasNewerApplication = candidateApplications.hasValidNewerApplication(activeApplciation, new_slot_index);
+        bootTimeline.endPhase(bootloader::BootTimeline::ScanSlots);
+        if(hasNewerApplication){
             tr_debug("New application available in slot %d", new_slot_index);
+#if MBED_CONF_APP_FULL_COMPARE
+            // byte-wise comparison, reads both applications entirely (debug only)
             activeApplciation.compareTo(candidateApplications.getBlockDeviceApplication(new_slot_index));
+#else
+            // metadata comparison, only the headers are read
+            const mbed::bd_addr_t candidateHeaderAddress =
+                storage_address + new_slot_index * (storage_size / nbr_of_slots);
+            bootloader::ApplicationHeader activeHeader;
+            bootloader::ApplicationHeader candidateHeader;
+            if (bootloader::readApplicationHeader(flashIAPBlockDevice, headerAddress, activeHeader) &&
+                bootloader::readApplicationHeader(flashIAPBlockDevice, candidateHeaderAddress, candidateHeader)) {
+                bootloader::printComparison(bootloader::compareHeaders(activeHeader, candidateHeader));
+            }
+#endif // MBED_CONF_APP_FULL_COMPARE
+            bootTimeline.endPhase(bootloader::BootTimeline::Compare);
 
             rc = candidateApplications.installApplication(new_slot_index, headerAddress);
+            bootTimeline.endPhase(bootloader::BootTimeline::Install);
             if (rc == update_client::UCErrorCode::UC_ERR_NONE)
             {
                 tr_debug("New application installed from slot %d", new_slot_index);
@@ -83,6 +106,8 @@ int main()
     // at this stage we directly branch to the main application
     void *sp = *((void **) POST_APPLICATION_ADDR + 0);  // NOLINT(readability/casting)
     void *pc = *((void **) POST_APPLICATION_ADDR + 1);  // NOLINT(readability/casting)
+    bootTimeline.endPhase(bootloader::BootTimeline::Jump);
+    bootTimeline.print();
     tr_debug("Starting application at address 0x%08x (sp 0x%08x, pc 0x%08x)\r\n", POST_APPLICATION_ADDR, (uint32_t) sp, (uint32_t) pc);
 
     mbed_start_application(POST_APPLICATION_ADDR);
@@ -0,0 +1,49 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file bike_system_stats.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Statistics printed by all bike system variants
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/bike_system_stats.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "BikeSystem"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+void printBikeSystemStats(advembsof::CPULogger& cpuLogger,
+                          const advembsof::TaskLogger& taskLogger,
+                          const LatencyStats& resetLatencyStats) {
+    cpuLogger.printStats();
+    for (uint8_t taskIndex = 0; taskIndex < advembsof::TaskLogger::kNbrOfTasks;
+         taskIndex++) {
+        tr_info("Task %d: period %" PRIu32 " us, computation time %" PRIu32 " us",
+                taskIndex,
+                static_cast<uint32_t>(taskLogger.getPeriod(taskIndex).count()),
+                static_cast<uint32_t>(taskLogger.getComputationTime(taskIndex).count()));
+    }
+    resetLatencyStats.printStats("Reset response time");
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,38 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file bike_system_stats.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Statistics printed by all bike system variants
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "cpu_logger.hpp"
+#include "latency_stats.hpp"
+#include "task_logger.hpp"
+
+namespace bike_computer {
+
+// CPU usage, period and computation time of each task and reset response time
+void printBikeSystemStats(advembsof::CPULogger& cpuLogger,  // NOLINT(runtime/references)
+                          const advembsof::TaskLogger& taskLogger,
+                          const LatencyStats& resetLatencyStats);
+
+}  // namespace bike_computer
@@ -0,0 +1,151 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file binary_trace.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Deferred binary trace implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/binary_trace.hpp"
+
+#include <cstring>
+
+#include "mbed_trace.h"
+#include "us_ticker_api.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "Trace"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+// format strings, indexed by TraceFormat, arguments are always uint32_t
+static const char* const kTraceFormats[] = {
+    "Reset task: response time is %" PRIu32 " usecs",
+    "Gear changed to %" PRIu32 " (gear size %" PRIu32 ")",
+    "Pedal rotation time changed to %" PRIu32 " msecs"};
+static_assert(sizeof(kTraceFormats) / sizeof(kTraceFormats[0]) ==
+                  static_cast<size_t>(TraceFormat::NbrOfFormats),
+              "One format string is required per TraceFormat");
+
+bool TraceChannel::write(TraceFormat format, uint32_t arg0, uint32_t arg1, uint32_t arg2) {
+    const uint32_t head = _head;
+    if (head - core_util_atomic_load_u32(&_tail) == kCapacity) {
+        _dropped = _dropped + 1;
+        return false;
+    }
+
+    TraceRecord& record = _records[head & (kCapacity - 1)];
+    record.timestamp    = us_ticker_read();
+    record.format       = format;
+    record.args[0]      = arg0;
+    record.args[1]      = arg1;
+    record.args[2]      = arg2;
+
+    // publish the record only once it is completely written
+    core_util_atomic_store_u32(&_head, head + 1);
+    return true;
+}
+
+bool TraceChannel::read(TraceRecord& record) {
+    const uint32_t tail = _tail;
+    if (core_util_atomic_load_u32(&_head) == tail) {
+        return false;
+    }
+
+    record = _records[tail & (kCapacity - 1)];
+
+    // release the slot only once it is copied
+    core_util_atomic_store_u32(&_tail, tail + 1);
+    return true;
+}
+
+const char* TraceChannel::getName() const { return _name; }
+
+uint32_t TraceChannel::getDroppedCount() const { return _dropped; }
+
+BinaryTrace& BinaryTrace::getInstance() {
+    static BinaryTrace binaryTrace;
+    return binaryTrace;
+}
+
+BinaryTrace::BinaryTrace() : _thread(osPriorityLow, OS_STACK_SIZE, nullptr, "TraceThread") {}
+
+TraceChannel* BinaryTrace::getChannel(const char* name) {
+    ScopedLock<Mutex> lock(_channelsMutex);
+    for (uint8_t index = 0; index < kMaxChannels; index++) {
+        TraceChannel& channel = _channels[index];
+        if (channel._name == nullptr) {
+            channel._name = name;
+            return &channel;
+        }
+        if (strcmp(channel._name, name) == 0) {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+void BinaryTrace::start() {
+    ScopedLock<Mutex> lock(_channelsMutex);
+    if (!_started) {
+        _started = true;
+        _thread.start(callback(this, &BinaryTrace::drain));
+    }
+}
+
+void BinaryTrace::drain() {
+    uint32_t lastDropped[kMaxChannels] = {0};
+    while (true) {
+        for (uint8_t index = 0; index < kMaxChannels; index++) {
+            TraceChannel& channel = _channels[index];
+            TraceRecord record;
+            while (channel.read(record)) {
+                print(record);
+            }
+            const uint32_t dropped = channel.getDroppedCount();
+            if (dropped != lastDropped[index]) {
+                tr_warn("%s: %" PRIu32 " trace records dropped",
+                        channel.getName(),
+                        dropped - lastDropped[index]);
+                lastDropped[index] = dropped;
+            }
+        }
+        ThisThread::sleep_for(kDrainPeriod);
+    }
+}
+
+void BinaryTrace::print(const TraceRecord& record) {
+    const auto formatIndex = static_cast<size_t>(record.format);
+    if (formatIndex >= static_cast<size_t>(TraceFormat::NbrOfFormats)) {
+        return;
+    }
+
+    static constexpr size_t kMessageSize = 96;
+    char message[kMessageSize];
+    snprintf(message,  // NOLINT(runtime/printf)
+             kMessageSize,
+             kTraceFormats[formatIndex],
+             record.args[0],
+             record.args[1],
+             record.args[2]);
+    tr_info("[%" PRIu32 " us] %s", record.timestamp, message);
+}
+
+}  // namespace bike_computer
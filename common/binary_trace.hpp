@@ -0,0 +1,113 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file binary_trace.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Deferred binary trace: call sites only store a format id and raw
+ *        arguments, formatting is done by a low priority drain thread
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// identifiers of the trace formats (see kTraceFormats in binary_trace.cpp)
+enum class TraceFormat : uint16_t {
+    ResetResponseTime = 0,
+    GearChanged,
+    PedalRotationChanged,
+    NbrOfFormats
+};
+
+struct TraceRecord {
+    uint32_t timestamp;
+    TraceFormat format;
+    uint32_t args[3];
+};
+
+// single producer (the owning thread), single consumer (the drain thread) ring
+// buffer, no lock is taken on either side
+class TraceChannel {
+   public:
+    TraceChannel() = default;
+
+    // make the class non copyable
+    TraceChannel(TraceChannel&)            = delete;
+    TraceChannel& operator=(TraceChannel&) = delete;
+
+    // called by the owning thread only, returns false if the record was dropped
+    bool write(TraceFormat format,
+               uint32_t arg0 = 0,
+               uint32_t arg1 = 0,
+               uint32_t arg2 = 0);
+
+    // called by the drain thread only, returns false if the channel is empty
+    bool read(TraceRecord& record);  // NOLINT(runtime/references)
+
+    const char* getName() const;
+    uint32_t getDroppedCount() const;
+
+   private:
+    friend class BinaryTrace;
+
+    // must be a power of 2
+    static constexpr uint32_t kCapacity = 32;
+
+    TraceRecord _records[kCapacity] = {};
+    // written by the producer only
+    volatile uint32_t _head = 0;
+    // written by the consumer only
+    volatile uint32_t _tail    = 0;
+    volatile uint32_t _dropped = 0;
+    const char* _name          = nullptr;
+};
+
+class BinaryTrace {
+   public:
+    static BinaryTrace& getInstance();
+
+    // make the class non copyable
+    BinaryTrace(BinaryTrace&)            = delete;
+    BinaryTrace& operator=(BinaryTrace&) = delete;
+
+    // returns the channel registered under name (one channel per thread),
+    // or nullptr if all channels are in use
+    TraceChannel* getChannel(const char* name);
+
+    // start the drain thread (only the first call has an effect)
+    void start();
+
+   private:
+    BinaryTrace();
+
+    void drain();
+    void print(const TraceRecord& record);
+
+    static constexpr uint8_t kMaxChannels = 4;
+    static constexpr std::chrono::milliseconds kDrainPeriod = 100ms;
+
+    TraceChannel _channels[kMaxChannels];
+    Mutex _channelsMutex;
+    Thread _thread;
+    bool _started = false;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,43 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file data_bus.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Publish/subscribe bus implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/data_bus.hpp"
+
+namespace bike_computer {
+
+// not a function local static: the first call may come from an ISR and must not
+// take the initialization guard
+DataBus DataBus::_instance;
+
+DataBus& DataBus::getInstance() { return _instance; }
+
+Topic<GearState>& DataBus::getGearTopic() { return _gearTopic; }
+
+Topic<float>& DataBus::getSpeedTopic() { return _speedTopic; }
+
+Topic<float>& DataBus::getDistanceTopic() { return _distanceTopic; }
+
+Topic<float>& DataBus::getTemperatureTopic() { return _temperatureTopic; }
+
+}  // namespace bike_computer
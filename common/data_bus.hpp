@@ -0,0 +1,154 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file data_bus.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Publish/subscribe bus with latest-value topics
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// a topic holds the latest published value only. Publishing copies the value
+// under a sequence number (odd while being written) in a short critical
+// section, so it may be done from any context, ISRs included. Readers never
+// block, they copy the value again if a publish happened in between.
+template <typename T>
+class Topic {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "topic values are copied, they must be trivially copyable");
+
+   public:
+    static constexpr uint8_t kMaxSubscribers = 4;
+
+    Topic() = default;
+
+    // make the class non copyable
+    Topic(Topic&)            = delete;
+    Topic& operator=(Topic&) = delete;
+
+    void publish(const T& value) {
+        core_util_critical_section_enter();
+        _sequence = _sequence + 1;
+        _value    = value;
+        _sequence = _sequence + 1;
+        core_util_critical_section_exit();
+
+        // wake the subscribers (EventFlags::set() may be called from ISRs)
+        const uint8_t nbrOfSubscribers = core_util_atomic_load_u8(&_nbrOfSubscribers);
+        for (uint8_t index = 0; index < nbrOfSubscribers; index++) {
+            _subscribers[index].eventFlags->set(_subscribers[index].flags);
+        }
+    }
+
+    // copy the latest value and return its version (0 if nothing was published)
+    uint32_t read(T& value) const {  // NOLINT(runtime/references)
+        uint32_t sequence;
+        do {
+            sequence = core_util_atomic_load_u32(&_sequence);
+            value    = _value;
+            // the copy must be done before the sequence is read again
+            MBED_BARRIER();
+        } while ((sequence & 1) != 0 ||
+                 sequence != core_util_atomic_load_u32(&_sequence));
+        return sequence / 2;
+    }
+
+    // copy the latest value only if it is newer than version, in which case
+    // version is updated and true is returned
+    bool readIfNewer(T& value, uint32_t& version) const {  // NOLINT(runtime/references)
+        if (getVersion() == version) {
+            return false;
+        }
+        version = read(value);
+        return true;
+    }
+
+    // incremented at each publish
+    uint32_t getVersion() const { return core_util_atomic_load_u32(&_sequence) / 2; }
+
+    // flags are set on eventFlags at each publish, returns false if all
+    // subscriber slots are in use (subscribers cannot be removed)
+    bool subscribe(EventFlags& eventFlags, uint32_t flags) {  // NOLINT
+        bool subscribed = false;
+        core_util_critical_section_enter();
+        if (_nbrOfSubscribers < kMaxSubscribers) {
+            _subscribers[_nbrOfSubscribers].eventFlags = &eventFlags;
+            _subscribers[_nbrOfSubscribers].flags      = flags;
+            // the slot is visible to publishers once it is written
+            _nbrOfSubscribers = _nbrOfSubscribers + 1;
+            subscribed        = true;
+        }
+        core_util_critical_section_exit();
+        return subscribed;
+    }
+
+   private:
+    struct Subscriber {
+        EventFlags* eventFlags;
+        uint32_t flags;
+    };
+
+    T _value                                 = {};
+    volatile uint32_t _sequence              = 0;
+    Subscriber _subscribers[kMaxSubscribers] = {};
+    volatile uint8_t _nbrOfSubscribers       = 0;
+};
+
+struct GearState {
+    uint8_t gear;
+    uint8_t gearSize;
+};
+
+// the bike state shared by the bike systems and their consumers (loggers,
+// statistics, ...), the control path only publishes to it
+class DataBus {
+   public:
+    // the bus is statically allocated, it may be used from ISRs
+    static DataBus& getInstance();
+
+    // make the class non copyable
+    DataBus(DataBus&)            = delete;
+    DataBus& operator=(DataBus&) = delete;
+
+    Topic<GearState>& getGearTopic();
+    // expressed in km / h
+    Topic<float>& getSpeedTopic();
+    // expressed in km
+    Topic<float>& getDistanceTopic();
+    // expressed in degrees Celsius
+    Topic<float>& getTemperatureTopic();
+
+   private:
+    DataBus() = default;
+
+    static DataBus _instance;
+
+    Topic<GearState> _gearTopic;
+    Topic<float> _speedTopic;
+    Topic<float> _distanceTopic;
+    Topic<float> _temperatureTopic;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,101 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file drivetrain.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Drivetrain profile implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/drivetrain.hpp"
+
+#include "common/constants.hpp"
+
+namespace bike_computer {
+
+static const DrivetrainProfile kDefaultProfile = {
+    2.1f, 1, {50, 0, 0}, kMaxGear, {19, 18, 17, 16, 15, 14, 13, 12, 11, 0, 0, 0, 0}};
+
+Drivetrain::Drivetrain() : _profile(kDefaultProfile) { computeTable(); }
+
+const DrivetrainProfile& Drivetrain::getDefaultProfile() { return kDefaultProfile; }
+
+bool Drivetrain::isValid(const DrivetrainProfile& profile) {
+    if (!(profile.wheelCircumference > 0.0f) || profile.nbrOfChainrings == 0 ||
+        profile.nbrOfChainrings > kMaxChainrings || profile.nbrOfCogs == 0 ||
+        profile.nbrOfCogs > kMaxCogs) {
+        return false;
+    }
+    for (uint8_t index = 0; index < profile.nbrOfChainrings; index++) {
+        if (profile.chainrings[index] == 0 || profile.chainrings[index] > kMaxTeeth) {
+            return false;
+        }
+    }
+    for (uint8_t index = 0; index < profile.nbrOfCogs; index++) {
+        if (profile.cassette[index] == 0 || profile.cassette[index] > kMaxTeeth) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Drivetrain::setProfile(const DrivetrainProfile& profile) {
+    if (!isValid(profile)) {
+        return false;
+    }
+    _profile = profile;
+    computeTable();
+    return true;
+}
+
+const DrivetrainProfile& Drivetrain::getProfile() const { return _profile; }
+
+float Drivetrain::getDistancePerTurn(uint8_t chainring, uint8_t cogSize) const {
+    if (chainring >= _profile.nbrOfChainrings || cogSize > kMaxTeeth) {
+        return 0.0f;
+    }
+    return _distancePerTurn[chainring][cogSize];
+}
+
+uint8_t Drivetrain::getNbrOfGears() const { return _profile.nbrOfCogs; }
+
+uint8_t Drivetrain::getCogSize(uint8_t gear) const {
+    if (gear < kMinGear || gear > _profile.nbrOfCogs) {
+        return 0;
+    }
+    return _profile.cassette[gear - kMinGear];
+}
+
+void Drivetrain::computeTable() {
+    // For a given chainring (plateau) and cog (pignon arrière), one pedal turn
+    // makes the wheel turn chainring / cog times. The table is computed for
+    // every cog size, so that any cog reported by a gear device can be used.
+    for (uint8_t chainring = 0; chainring < kMaxChainrings; chainring++) {
+        _distancePerTurn[chainring][0] = 0.0f;
+        for (uint8_t cogSize = 1; cogSize <= kMaxTeeth; cogSize++) {
+            _distancePerTurn[chainring][cogSize] =
+                chainring < _profile.nbrOfChainrings
+                    ? _profile.wheelCircumference *
+                          static_cast<float>(_profile.chainrings[chainring]) /
+                          static_cast<float>(cogSize)
+                    : 0.0f;
+        }
+    }
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,79 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file drivetrain.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Drivetrain profile (wheel, chainrings and cassette) loaded at runtime,
+ *        with the distance per pedal turn precomputed for every cog size
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+static constexpr uint8_t kMaxChainrings = 3;
+static constexpr uint8_t kMaxCogs       = 13;
+// largest cog or chainring supported (teeth)
+static constexpr uint8_t kMaxTeeth = 63;
+
+struct DrivetrainProfile {
+    // expressed in m
+    float wheelCircumference;
+    uint8_t nbrOfChainrings;
+    uint8_t chainrings[kMaxChainrings];
+    // cog sizes from the first gear (largest cog) to the last one
+    uint8_t nbrOfCogs;
+    uint8_t cassette[kMaxCogs];
+};
+
+class Drivetrain {
+   public:
+    // the default profile corresponds to the original bike (2.1 m wheel, one
+    // 50 teeth chainring, cogs from 19 to 11 teeth)
+    Drivetrain();
+
+    // make the class non copyable
+    Drivetrain(Drivetrain&)            = delete;
+    Drivetrain& operator=(Drivetrain&) = delete;
+
+    static const DrivetrainProfile& getDefaultProfile();
+    static bool isValid(const DrivetrainProfile& profile);
+
+    // change the profile and recompute the distance table (the profile is
+    // ignored if not valid)
+    bool setProfile(const DrivetrainProfile& profile);
+    const DrivetrainProfile& getProfile() const;
+
+    // distance per pedal turn (m), a table lookup
+    float getDistancePerTurn(uint8_t chainring, uint8_t cogSize) const;
+
+    // number of gears and cog size of a gear (from 1 to the number of gears)
+    uint8_t getNbrOfGears() const;
+    uint8_t getCogSize(uint8_t gear) const;
+
+   private:
+    void computeTable();
+
+    DrivetrainProfile _profile;
+    float _distancePerTurn[kMaxChainrings][kMaxTeeth + 1] = {};
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,349 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file flash_kv_store.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Log-structured key-value store implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/flash_kv_store.hpp"
+
+#include <cstring>
+
+#include "MbedCRC.h"
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "FlashKVStore"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+// area header: magic, sequence number and crc of both
+static constexpr uint32_t kAreaMagic          = 0x4b56534f;
+static constexpr uint32_t kAreaHeaderDataSize = 12;
+// record header: crc (of the key, the size and the value), key and size
+static constexpr uint32_t kRecordHeaderSize = 8;
+static constexpr uint32_t kRecordCRCSize    = 4;
+
+static uint32_t computeCRC(const uint8_t* data, uint32_t size) {
+    mbed::MbedCRC<POLY_32BIT_ANSI, 32> crc;
+    uint32_t result = 0;
+    crc.compute(data, size, &result);
+    return result;
+}
+
+FlashKVStore::FlashKVStore(mbed::BlockDevice& blockDevice,
+                           mbed::bd_addr_t address,
+                           mbed::bd_size_t size)
+    : _blockDevice(blockDevice), _address(address), _areaSize(size / 2) {}
+
+KVReturnCode FlashKVStore::init() {
+    ScopedLock<Mutex> lock(_mutex);
+    if (_blockDevice.init() != 0) {
+        tr_error("Cannot initialize the block device");
+        return KVReturnCode::DeviceError;
+    }
+    _programSize         = static_cast<uint32_t>(_blockDevice.get_program_size());
+    const int eraseValue = _blockDevice.get_erase_value();
+    _eraseValue          = eraseValue < 0 ? 0xFF : static_cast<uint8_t>(eraseValue);
+    if (getRecordSize(kMaxValueSize) > kBufferSize || getAreaHeaderSize() > kBufferSize ||
+        !_blockDevice.is_valid_erase(_address, _areaSize) ||
+        !_blockDevice.is_valid_erase(_address + _areaSize, _areaSize)) {
+        tr_error("Invalid store geometry (program size %" PRIu32 ")", _programSize);
+        return KVReturnCode::InvalidSize;
+    }
+
+    // the active area is the valid one with the most recent sequence number
+    uint32_t sequences[2] = {0};
+    const bool valid[2]   = {readAreaHeader(getAreaAddress(0), sequences[0]),
+                             readAreaHeader(getAreaAddress(1), sequences[1])};
+    if (!valid[0] && !valid[1]) {
+        tr_info("No valid area, formatting the store");
+        return format();
+    }
+    if (valid[0] && valid[1]) {
+        _activeArea = static_cast<int32_t>(sequences[1] - sequences[0]) > 0 ? 1 : 0;
+    } else {
+        _activeArea = valid[0] ? 0 : 1;
+    }
+    _sequence = sequences[_activeArea];
+
+    return scanArea();
+}
+
+KVReturnCode FlashKVStore::get(uint16_t key,
+                               void* buffer,
+                               uint32_t size,
+                               uint32_t& actualSize) {
+    ScopedLock<Mutex> lock(_mutex);
+    const IndexEntry* entry = findEntry(key);
+    if (entry == nullptr) {
+        return KVReturnCode::NotFound;
+    }
+    actualSize = entry->size;
+    if (size < entry->size) {
+        return KVReturnCode::InvalidSize;
+    }
+    if (_blockDevice.read(
+            buffer, getAreaAddress(_activeArea) + entry->offset, entry->size) != 0) {
+        return KVReturnCode::DeviceError;
+    }
+    return KVReturnCode::Ok;
+}
+
+KVReturnCode FlashKVStore::set(uint16_t key, const void* value, uint32_t size) {
+    ScopedLock<Mutex> lock(_mutex);
+    if (size > kMaxValueSize) {
+        return KVReturnCode::InvalidSize;
+    }
+    IndexEntry* entry = findEntry(key);
+    if (entry == nullptr && _nbrOfKeys == kMaxKeys) {
+        return KVReturnCode::TooManyKeys;
+    }
+
+    if (_writeOffset + getRecordSize(size) > _areaSize) {
+        return compact(key, value, size);
+    }
+
+    const uint32_t recordOffset = _writeOffset;
+    KVReturnCode rc =
+        append(getAreaAddress(_activeArea), _writeOffset, key, value, size);
+    if (rc != KVReturnCode::Ok) {
+        // the tail of the area may be partially programmed, do not use it anymore
+        _writeOffset = _areaSize;
+        return rc;
+    }
+    if (entry == nullptr) {
+        entry      = &_index[_nbrOfKeys++];
+        entry->key = key;
+    }
+    entry->size   = static_cast<uint16_t>(size);
+    entry->offset = recordOffset + kRecordHeaderSize;
+    return KVReturnCode::Ok;
+}
+
+uint32_t FlashKVStore::getCompactionCount() const { return _compactionCount; }
+
+KVReturnCode FlashKVStore::format() {
+    if (_blockDevice.erase(getAreaAddress(0), _areaSize) != 0) {
+        return KVReturnCode::DeviceError;
+    }
+    _activeArea  = 0;
+    _sequence    = 1;
+    _nbrOfKeys   = 0;
+    _writeOffset = getAreaHeaderSize();
+    return writeAreaHeader(getAreaAddress(0), _sequence);
+}
+
+KVReturnCode FlashKVStore::scanArea() {
+    const mbed::bd_addr_t areaAddress = getAreaAddress(_activeArea);
+    _nbrOfKeys                        = 0;
+    uint32_t offset                   = getAreaHeaderSize();
+    bool corrupted                    = false;
+    while (offset + kRecordHeaderSize <= _areaSize) {
+        if (_blockDevice.read(_buffer, areaAddress + offset, kRecordHeaderSize) != 0) {
+            return KVReturnCode::DeviceError;
+        }
+        bool erased = true;
+        for (uint32_t index = 0; index < kRecordHeaderSize; index++) {
+            erased = erased && _buffer[index] == _eraseValue;
+        }
+        if (erased) {
+            break;
+        }
+
+        uint32_t crc  = 0;
+        uint16_t key  = 0;
+        uint16_t size = 0;
+        memcpy(&crc, _buffer, sizeof(crc));
+        memcpy(&key, _buffer + 4, sizeof(key));
+        memcpy(&size, _buffer + 6, sizeof(size));
+        if (size > kMaxValueSize || offset + getRecordSize(size) > _areaSize ||
+            _blockDevice.read(_buffer + kRecordHeaderSize,
+                              areaAddress + offset + kRecordHeaderSize,
+                              size) != 0 ||
+            computeCRC(_buffer + kRecordCRCSize,
+                       kRecordHeaderSize - kRecordCRCSize + size) != crc) {
+            // most likely a record interrupted by a reset, the records before
+            // it are valid
+            corrupted = true;
+            break;
+        }
+
+        IndexEntry* entry = findEntry(key);
+        if (entry == nullptr) {
+            if (_nbrOfKeys == kMaxKeys) {
+                corrupted = true;
+                break;
+            }
+            entry      = &_index[_nbrOfKeys++];
+            entry->key = key;
+        }
+        entry->size   = size;
+        entry->offset = offset + kRecordHeaderSize;
+        offset += getRecordSize(size);
+    }
+    _writeOffset = offset;
+
+    tr_debug("Area %d (sequence %" PRIu32 "): %d keys, %" PRIu32 " bytes used",
+             _activeArea,
+             _sequence,
+             _nbrOfKeys,
+             _writeOffset);
+
+    if (corrupted) {
+        // never program over a partially written record, move the valid
+        // records to the other area
+        tr_warn("Corrupted record at offset %" PRIu32 ", compacting", offset);
+        _writeOffset = _areaSize;
+        return compact(0, nullptr, 0);
+    }
+    return KVReturnCode::Ok;
+}
+
+KVReturnCode FlashKVStore::compact(uint16_t key, const void* value, uint32_t size) {
+    const uint8_t newArea                = _activeArea == 0 ? 1 : 0;
+    const mbed::bd_addr_t oldAreaAddress = getAreaAddress(_activeArea);
+    const mbed::bd_addr_t newAreaAddress = getAreaAddress(newArea);
+    if (_blockDevice.erase(newAreaAddress, _areaSize) != 0) {
+        return KVReturnCode::DeviceError;
+    }
+
+    // copy the latest value of each key, except the one being set
+    IndexEntry newIndex[kMaxKeys] = {};
+    uint8_t nbrOfKeys             = 0;
+    uint32_t offset               = getAreaHeaderSize();
+    uint8_t valueBuffer[kMaxValueSize];
+    for (uint8_t index = 0; index < _nbrOfKeys; index++) {
+        const IndexEntry& entry = _index[index];
+        if (value != nullptr && entry.key == key) {
+            continue;
+        }
+        if (_blockDevice.read(valueBuffer, oldAreaAddress + entry.offset, entry.size) !=
+            0) {
+            return KVReturnCode::DeviceError;
+        }
+        newIndex[nbrOfKeys] = {entry.key, entry.size, offset + kRecordHeaderSize};
+        KVReturnCode rc =
+            append(newAreaAddress, offset, entry.key, valueBuffer, entry.size);
+        if (rc != KVReturnCode::Ok) {
+            return rc;
+        }
+        nbrOfKeys++;
+    }
+    if (value != nullptr) {
+        newIndex[nbrOfKeys] = {
+            key, static_cast<uint16_t>(size), offset + kRecordHeaderSize};
+        KVReturnCode rc = append(newAreaAddress, offset, key, value, size);
+        if (rc != KVReturnCode::Ok) {
+            return rc;
+        }
+        nbrOfKeys++;
+    }
+
+    // the new area becomes valid (and the old one obsolete) once its header is
+    // written, a reset before this point leaves the old area active
+    KVReturnCode rc = writeAreaHeader(newAreaAddress, _sequence + 1);
+    if (rc != KVReturnCode::Ok) {
+        return rc;
+    }
+
+    _activeArea  = newArea;
+    _sequence    = _sequence + 1;
+    _writeOffset = offset;
+    _nbrOfKeys   = nbrOfKeys;
+    memcpy(_index, newIndex, sizeof(_index));
+    _compactionCount++;
+    tr_debug("Compacted to area %d, %" PRIu32 " bytes used", _activeArea, _writeOffset);
+    return KVReturnCode::Ok;
+}
+
+KVReturnCode FlashKVStore::append(mbed::bd_addr_t areaAddress,
+                                  uint32_t& offset,
+                                  uint16_t key,
+                                  const void* value,
+                                  uint32_t size) {
+    const uint32_t recordSize = getRecordSize(size);
+    const uint16_t valueSize  = static_cast<uint16_t>(size);
+    memset(_buffer, _eraseValue, recordSize);
+    memcpy(_buffer + 4, &key, sizeof(key));
+    memcpy(_buffer + 6, &valueSize, sizeof(valueSize));
+    memcpy(_buffer + kRecordHeaderSize, value, size);
+    const uint32_t crc =
+        computeCRC(_buffer + kRecordCRCSize, kRecordHeaderSize - kRecordCRCSize + size);
+    memcpy(_buffer, &crc, sizeof(crc));
+
+    if (_blockDevice.program(_buffer, areaAddress + offset, recordSize) != 0) {
+        return KVReturnCode::DeviceError;
+    }
+    offset += recordSize;
+    return KVReturnCode::Ok;
+}
+
+KVReturnCode FlashKVStore::writeAreaHeader(mbed::bd_addr_t areaAddress,
+                                           uint32_t sequence) {
+    const uint32_t headerSize = getAreaHeaderSize();
+    memset(_buffer, _eraseValue, headerSize);
+    memcpy(_buffer, &kAreaMagic, sizeof(kAreaMagic));
+    memcpy(_buffer + 4, &sequence, sizeof(sequence));
+    const uint32_t crc = computeCRC(_buffer, 8);
+    memcpy(_buffer + 8, &crc, sizeof(crc));
+    if (_blockDevice.program(_buffer, areaAddress, headerSize) != 0) {
+        return KVReturnCode::DeviceError;
+    }
+    return KVReturnCode::Ok;
+}
+
+bool FlashKVStore::readAreaHeader(mbed::bd_addr_t areaAddress, uint32_t& sequence) {
+    if (_blockDevice.read(_buffer, areaAddress, kAreaHeaderDataSize) != 0) {
+        return false;
+    }
+    uint32_t magic = 0;
+    uint32_t crc   = 0;
+    memcpy(&magic, _buffer, sizeof(magic));
+    memcpy(&sequence, _buffer + 4, sizeof(sequence));
+    memcpy(&crc, _buffer + 8, sizeof(crc));
+    return magic == kAreaMagic && computeCRC(_buffer, 8) == crc;
+}
+
+FlashKVStore::IndexEntry* FlashKVStore::findEntry(uint16_t key) {
+    for (uint8_t index = 0; index < _nbrOfKeys; index++) {
+        if (_index[index].key == key) {
+            return &_index[index];
+        }
+    }
+    return nullptr;
+}
+
+uint32_t FlashKVStore::getRecordSize(uint32_t valueSize) const {
+    // records are padded to the program size
+    return ((kRecordHeaderSize + valueSize + _programSize - 1) / _programSize) *
+           _programSize;
+}
+
+uint32_t FlashKVStore::getAreaHeaderSize() const {
+    return ((kAreaHeaderDataSize + _programSize - 1) / _programSize) * _programSize;
+}
+
+mbed::bd_addr_t FlashKVStore::getAreaAddress(uint8_t area) const {
+    return _address + area * _areaSize;
+}
+
+}  // namespace bike_computer
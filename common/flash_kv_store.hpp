@@ -0,0 +1,124 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file flash_kv_store.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Small log-structured key-value store over a block device region.
+ *        The region is split in two areas of at least one erase unit: records
+ *        are appended to the active area and the latest value of each key is
+ *        copied to the other area when the active one is full
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "BlockDevice.h"
+#include "mbed.h"
+
+namespace bike_computer {
+
+// keys used by the bike computer
+static constexpr uint16_t kOdometerKey          = 1;
+static constexpr uint16_t kDrivetrainProfileKey = 2;
+
+enum class KVReturnCode : uint8_t {
+    Ok = 0,
+    NotFound,
+    InvalidSize,
+    TooManyKeys,
+    NoValidArea,
+    DeviceError
+};
+
+class FlashKVStore {
+   public:
+    // address and size are relative to the block device, the size must be a
+    // multiple of two erase units
+    FlashKVStore(mbed::BlockDevice& blockDevice,  // NOLINT(runtime/references)
+                 mbed::bd_addr_t address,
+                 mbed::bd_size_t size);
+
+    // make the class non copyable
+    FlashKVStore(FlashKVStore&)            = delete;
+    FlashKVStore& operator=(FlashKVStore&) = delete;
+
+    // initialize the block device and rebuild the key index from the most
+    // recent valid area (the store is formatted if no area is valid)
+    KVReturnCode init();
+
+    // read the latest value of key, size is the size of the buffer and
+    // actualSize the size of the stored value
+    KVReturnCode get(uint16_t key, void* buffer, uint32_t size, uint32_t& actualSize);
+
+    // append a new value for key (a compaction may take place, which includes
+    // the erase of one area)
+    KVReturnCode set(uint16_t key, const void* value, uint32_t size);
+
+    // number of compactions since init()
+    uint32_t getCompactionCount() const;
+
+    static constexpr uint32_t kMaxValueSize = 32;
+    static constexpr uint8_t kMaxKeys       = 8;
+
+   private:
+    struct IndexEntry {
+        uint16_t key;
+        uint16_t size;
+        // offset of the value, relative to the area
+        uint32_t offset;
+    };
+
+    KVReturnCode format();
+    KVReturnCode scanArea();
+    KVReturnCode compact(uint16_t key, const void* value, uint32_t size);
+    KVReturnCode append(mbed::bd_addr_t areaAddress,
+                        uint32_t& offset,  // NOLINT(runtime/references)
+                        uint16_t key,
+                        const void* value,
+                        uint32_t size);
+    KVReturnCode writeAreaHeader(mbed::bd_addr_t areaAddress, uint32_t sequence);
+    bool readAreaHeader(mbed::bd_addr_t areaAddress,
+                        uint32_t& sequence);  // NOLINT(runtime/references)
+    IndexEntry* findEntry(uint16_t key);
+    uint32_t getRecordSize(uint32_t valueSize) const;
+    uint32_t getAreaHeaderSize() const;
+    mbed::bd_addr_t getAreaAddress(uint8_t area) const;
+
+    mbed::BlockDevice& _blockDevice;
+    // calls may be made from different threads, a call may last for an erase
+    Mutex _mutex;
+    mbed::bd_addr_t _address;
+    mbed::bd_size_t _areaSize;
+    uint32_t _programSize = 1;
+    uint8_t _eraseValue   = 0xFF;
+
+    uint8_t _activeArea   = 0;
+    uint32_t _sequence    = 0;
+    uint32_t _writeOffset = 0;
+
+    IndexEntry _index[kMaxKeys] = {};
+    uint8_t _nbrOfKeys          = 0;
+    uint32_t _compactionCount   = 0;
+
+    // records are built here before being programmed (record header, value and
+    // padding up to the program size)
+    static constexpr uint32_t kBufferSize = 64;
+    uint8_t _buffer[kBufferSize]          = {0};
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,217 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file heap_monitor.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Heap and event queue instrumentation implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/heap_monitor.hpp"
+
+#include "EventQueue.h"
+#include "mbed_error.h"
+#include "mbed_mem_trace.h"
+#include "mbed_stats.h"
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "HeapMonitor"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+#if !defined(MBED_CONF_APP_HEAP_STEADY_STATE_TRAP)
+#define MBED_CONF_APP_HEAP_STEADY_STATE_TRAP 0
+#endif
+
+#if MBED_CONF_APP_HEAP_STEADY_STATE_TRAP && !defined(MBED_MEM_TRACING_ENABLED)
+#error "heap-steady-state-trap requires platform.memory-tracing-enabled"
+#endif
+
+namespace bike_computer {
+
+#if defined(MBED_MEM_TRACING_ENABLED)
+// installed when entering steady state, called with the trace lock held: it
+// must neither allocate nor log
+static void steadyStateTraceCallback(uint8_t op, void* res, void* caller, ...) {
+    if (op == MBED_MEM_TRACE_FREE) {
+        return;
+    }
+    HeapMonitor::getInstance().onSteadyStateAllocation(caller);
+}
+#endif  // defined(MBED_MEM_TRACING_ENABLED)
+
+static const char* const kHeapTagNames[] = {
+    "display", "sensor", "logging", "update client", "tasks"};
+static_assert(sizeof(kHeapTagNames) / sizeof(kHeapTagNames[0]) ==
+                  static_cast<size_t>(HeapTag::NbrOfTags),
+              "One name is required per HeapTag");
+
+HeapMonitor& HeapMonitor::getInstance() {
+    static HeapMonitor heapMonitor;
+    return heapMonitor;
+}
+
+void HeapMonitor::beginTag(HeapTag tag) {
+    _tagMutex.lock();
+    mbed_stats_heap_t heapStats;
+    mbed_stats_heap_get(&heapStats);
+    _currentTag      = tag;
+    _tagStartSize    = heapStats.current_size;
+    _tagStartMaxSize = heapStats.max_size;
+}
+
+void HeapMonitor::endTag() {
+    if (_currentTag == HeapTag::NbrOfTags) {
+        return;
+    }
+    mbed_stats_heap_t heapStats;
+    mbed_stats_heap_get(&heapStats);
+
+    TagStats& stats = _tagStats[static_cast<uint8_t>(_currentTag)];
+    // if the global high-water mark moved within the scope, it was reached by
+    // this subsystem
+    const uint32_t peakInScope =
+        heapStats.max_size > _tagStartMaxSize ? heapStats.max_size - _tagStartSize
+        : heapStats.current_size > _tagStartSize ? heapStats.current_size - _tagStartSize
+                                                 : 0;
+    const uint32_t peak = stats.currentSize + peakInScope;
+    if (peak > stats.maxSize) {
+        stats.maxSize = peak;
+    }
+    stats.currentSize += static_cast<int32_t>(heapStats.current_size) -
+                         static_cast<int32_t>(_tagStartSize);
+    _currentTag = HeapTag::NbrOfTags;
+    _tagMutex.unlock();
+}
+
+void HeapMonitor::enterSteadyState() {
+    mbed_stats_heap_t heapStats;
+    mbed_stats_heap_get(&heapStats);
+    _steadyStateAllocCount = heapStats.alloc_cnt;
+    _steadyState           = true;
+    tr_info("Entering steady state, heap is %" PRIu32 " bytes (max %" PRIu32 " bytes)",
+            heapStats.current_size,
+            heapStats.max_size);
+#if defined(MBED_MEM_TRACING_ENABLED)
+    mbed_mem_trace_set_callback(steadyStateTraceCallback);
+#endif  // defined(MBED_MEM_TRACING_ENABLED)
+}
+
+void HeapMonitor::leaveSteadyState() {
+    if (!_steadyState) {
+        return;
+    }
+#if defined(MBED_MEM_TRACING_ENABLED)
+    mbed_mem_trace_set_callback(nullptr);
+#endif  // defined(MBED_MEM_TRACING_ENABLED)
+    _steadyState = false;
+    tr_info("Leaving steady state");
+}
+
+void HeapMonitor::onSteadyStateAllocation(void* caller) {
+    const uint32_t callerAddress =
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(caller));
+#if MBED_CONF_APP_HEAP_STEADY_STATE_TRAP
+    // the fault is raised in the allocating thread, with the allocation site
+    MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_APPLICATION,
+                                MBED_ERROR_CODE_INVALID_OPERATION),
+                "Heap allocation in steady state",
+                callerAddress);
+#else
+    uint32_t noCaller = 0;
+    if (core_util_atomic_cas_u32(&_steadyStateCaller, &noCaller, callerAddress)) {
+        _steadyStateThreadId = ThisThread::get_id();
+    }
+#endif  // MBED_CONF_APP_HEAP_STEADY_STATE_TRAP
+}
+
+void HeapMonitor::printStats() {
+    mbed_stats_heap_t heapStats;
+    mbed_stats_heap_get(&heapStats);
+
+    if (_steadyState && heapStats.alloc_cnt != _steadyStateAllocCount) {
+        tr_error("%" PRIu32 " heap allocations in steady state",
+                 heapStats.alloc_cnt - _steadyStateAllocCount);
+        _steadyStateAllocCount = heapStats.alloc_cnt;
+    }
+    const uint32_t caller = core_util_atomic_load_u32(&_steadyStateCaller);
+    if (caller != 0) {
+        const char* threadName = osThreadGetName(_steadyStateThreadId);
+        tr_error("First steady state allocation from 0x%08" PRIx32 " (thread %s)",
+                 caller,
+                 threadName != nullptr ? threadName : "unknown");
+    }
+
+    tr_info("Heap: %" PRIu32 " bytes (max %" PRIu32 " bytes, %" PRIu32 " failed)",
+            heapStats.current_size,
+            heapStats.max_size,
+            heapStats.alloc_fail_cnt);
+    for (uint8_t tag = 0; tag < static_cast<uint8_t>(HeapTag::NbrOfTags); tag++) {
+        tr_info("  %s: %" PRId32 " bytes (max %" PRIu32 " bytes)",
+                kHeapTagNames[tag],
+                _tagStats[tag].currentSize,
+                _tagStats[tag].maxSize);
+    }
+}
+
+EventQueueMonitor::EventQueueMonitor(const char* name) : _name(name) {}
+
+void EventQueueMonitor::recordPeriodicPost(bool posted) {
+    if (posted) {
+        core_util_atomic_incr_u32(&_periodicEvents, 1);
+    } else {
+        core_util_atomic_incr_u32(&_failedPosts, 1);
+    }
+}
+
+void EventQueueMonitor::recordPost(bool posted) {
+    if (!posted) {
+        core_util_atomic_incr_u32(&_failedPosts, 1);
+        return;
+    }
+    core_util_critical_section_enter();
+    _pendingEvents = _pendingEvents + 1;
+    if (_pendingEvents > _maxPending) {
+        _maxPending = _pendingEvents;
+    }
+    core_util_critical_section_exit();
+}
+
+void EventQueueMonitor::recordDispatch() {
+    core_util_critical_section_enter();
+    if (_pendingEvents > 0) {
+        _pendingEvents = _pendingEvents - 1;
+    }
+    core_util_critical_section_exit();
+}
+
+void EventQueueMonitor::printStats() const {
+    // the pool is shared by all events, each one using about EVENTS_EVENT_SIZE
+    const uint32_t maxSlots = _periodicEvents + _maxPending;
+    tr_info("%s: %" PRIu32 " periodic, %" PRIu32 " pending (max %" PRIu32
+            "), ~%" PRIu32 "/%" PRIu32 " bytes, %" PRIu32 " failed posts",
+            _name,
+            _periodicEvents,
+            _pendingEvents,
+            _maxPending,
+            static_cast<uint32_t>(maxSlots * EVENTS_EVENT_SIZE),
+            static_cast<uint32_t>(EVENTS_QUEUE_SIZE),
+            _failedPosts);
+}
+
+}  // namespace bike_computer
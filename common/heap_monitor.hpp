@@ -0,0 +1,132 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file heap_monitor.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Heap usage per subsystem, event queue occupancy and steady-state
+ *        allocation detection
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// subsystems to which heap usage is attributed
+enum class HeapTag : uint8_t {
+    Display = 0,
+    Sensor,
+    Logging,
+    UpdateClient,
+    Tasks,
+    NbrOfTags
+};
+
+class HeapMonitor {
+   public:
+    static HeapMonitor& getInstance();
+
+    // make the class non copyable
+    HeapMonitor(HeapMonitor&)            = delete;
+    HeapMonitor& operator=(HeapMonitor&) = delete;
+
+    // called by HeapTagScope, usage is attributed from heap statistics deltas.
+    // Scopes must not be nested, scopes of concurrent threads are serialized (a
+    // scope waits until the scope of another thread ends). Allocations of threads
+    // without scope in the meantime are attributed to the scope.
+    void beginTag(HeapTag tag);
+    void endTag();
+
+    // from now on, any heap allocation is reported (or trapped, see the
+    // "heap-steady-state-trap" configuration)
+    void enterSteadyState();
+
+    // allocations are allowed again, to be called before the threads of the bike
+    // system are destroyed (the next bike system allocates its thread stacks)
+    void leaveSteadyState();
+
+    // called by the memory trace hook on each allocation in steady state, from
+    // the allocating thread
+    void onSteadyStateAllocation(void* caller);
+
+    // check for steady state allocations and print the usage per subsystem
+    void printStats();
+
+   private:
+    HeapMonitor() = default;
+
+    struct TagStats {
+        int32_t currentSize;
+        uint32_t maxSize;
+    };
+
+    // held from beginTag() to endTag()
+    Mutex _tagMutex;
+    TagStats _tagStats[static_cast<uint8_t>(HeapTag::NbrOfTags)] = {};
+    HeapTag _currentTag                                         = HeapTag::NbrOfTags;
+    uint32_t _tagStartSize                                      = 0;
+    uint32_t _tagStartMaxSize                                   = 0;
+
+    bool _steadyState               = false;
+    uint32_t _steadyStateAllocCount = 0;
+    // first allocation site and thread seen by the hook (reported once)
+    volatile uint32_t _steadyStateCaller = 0;
+    osThreadId_t _steadyStateThreadId    = nullptr;
+};
+
+// attributes the heap allocated during its lifetime to a subsystem
+class HeapTagScope {
+   public:
+    explicit HeapTagScope(HeapTag tag) { HeapMonitor::getInstance().beginTag(tag); }
+    ~HeapTagScope() { HeapMonitor::getInstance().endTag(); }
+
+    // make the class non copyable
+    HeapTagScope(HeapTagScope&)            = delete;
+    HeapTagScope& operator=(HeapTagScope&) = delete;
+};
+
+// pool occupancy and failed posts of an EventQueue, call sites report their
+// posts and the handlers report their dispatch
+class EventQueueMonitor {
+   public:
+    explicit EventQueueMonitor(const char* name);
+
+    // make the class non copyable
+    EventQueueMonitor(EventQueueMonitor&)            = delete;
+    EventQueueMonitor& operator=(EventQueueMonitor&) = delete;
+
+    // periodic events keep their slot for the lifetime of the queue
+    void recordPeriodicPost(bool posted);
+
+    // may be called from ISR context
+    void recordPost(bool posted);
+    void recordDispatch();
+
+    void printStats() const;
+
+   private:
+    const char* _name;
+    volatile uint32_t _periodicEvents = 0;
+    volatile uint32_t _pendingEvents  = 0;
+    volatile uint32_t _maxPending     = 0;
+    volatile uint32_t _failedPosts    = 0;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,114 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file init_graph.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Init job graph implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include "common/init_graph.hpp"
+
+#include "common/startup_timeline.hpp"
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "InitGraph"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+InitGraph::InitGraph()
+    : _thread(osPriorityNormal,
+              MBED_CONF_APP_INIT_THREAD_STACK_SIZE,
+              nullptr,
+              "InitThread") {}
+
+InitGraph::JobId InitGraph::addJob(const char* name,
+                                   Callback<void()> callback,
+                                   uint32_t dependencies) {
+    // only jobs added before can be depended on, the graph has no cycle
+    const uint32_t knownJobs = (1UL << _nbrOfJobs) - 1;
+    if (_nbrOfJobs == kMaxJobs || (dependencies & ~knownJobs) != 0) {
+        tr_error("Cannot add init job %s", name);
+        return kInvalidJobId;
+    }
+    _jobs[_nbrOfJobs].name         = name;
+    _jobs[_nbrOfJobs].callback     = callback;
+    _jobs[_nbrOfJobs].dependencies = dependencies;
+    return _nbrOfJobs++;
+}
+
+void InitGraph::run() {
+    if (_nbrOfJobs > 1) {
+        _thread.start(callback(this, &InitGraph::runJobs));
+        runJobs();
+        _thread.join();
+    } else {
+        runJobs();
+    }
+}
+
+void InitGraph::runJobs() {
+    const uint32_t allJobs = (1UL << _nbrOfJobs) - 1;
+    while (true) {
+        JobId jobId = kInvalidJobId;
+        _mutex.lock();
+        if (_doneJobs == allJobs) {
+            _mutex.unlock();
+            return;
+        }
+        jobId = takeReadyJob();
+        if (jobId == kInvalidJobId) {
+            // the flag is cleared under the mutex, a job done from now on sets it
+            // again and wakes all waiting threads
+            _eventFlags.clear(kJobDoneFlag);
+        }
+        _mutex.unlock();
+
+        if (jobId == kInvalidJobId) {
+            _eventFlags.wait_any(kJobDoneFlag, osWaitForever, false);
+            continue;
+        }
+
+        StartupTimeline& startupTimeline          = StartupTimeline::getInstance();
+        const std::chrono::microseconds startTime = startupTimeline.now();
+        _jobs[jobId].callback();
+        startupTimeline.record(_jobs[jobId].name, startTime, startupTimeline.now());
+
+        _mutex.lock();
+        _doneJobs |= dependsOn(jobId);
+        _eventFlags.set(kJobDoneFlag);
+        _mutex.unlock();
+    }
+}
+
+InitGraph::JobId InitGraph::takeReadyJob() {
+    for (JobId jobId = 0; jobId < _nbrOfJobs; jobId++) {
+        const uint32_t jobMask = dependsOn(jobId);
+        if ((_startedJobs & jobMask) == 0 &&
+            (_jobs[jobId].dependencies & ~_doneJobs) == 0) {
+            _startedJobs |= jobMask;
+            return jobId;
+        }
+    }
+    return kInvalidJobId;
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,86 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file init_graph.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Dependency graph of init jobs run concurrently
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// init jobs with their dependencies: a job starts once the jobs it depends on are
+// done, independent jobs run concurrently on the calling thread and on a worker
+// thread. The start and end of each job are recorded in the startup timeline.
+// A graph is run once.
+class InitGraph {
+   public:
+    using JobId = uint8_t;
+
+    static constexpr uint8_t kMaxJobs       = 8;
+    static constexpr JobId kInvalidJobId    = 0xFF;
+    static constexpr uint32_t kNoDependency = 0;
+
+    InitGraph();
+
+    // make the class non copyable
+    InitGraph(InitGraph&)            = delete;
+    InitGraph& operator=(InitGraph&) = delete;
+
+    // mask of the dependencies of a job, to be combined with |
+    static constexpr uint32_t dependsOn(JobId jobId) { return (1UL << jobId); }
+
+    // a job may only depend on jobs added before it, returns kInvalidJobId if the
+    // graph is full or if a dependency is unknown
+    JobId addJob(const char* name,
+                 Callback<void()> callback,
+                 uint32_t dependencies = kNoDependency);
+
+    // run all jobs and return once they are done
+    void run();
+
+   private:
+    void runJobs();
+    // must be called with the mutex locked, marks the job as started
+    JobId takeReadyJob();
+
+    static constexpr uint32_t kJobDoneFlag = (1UL << 0);
+
+    struct Job {
+        const char* name;
+        Callback<void()> callback;
+        uint32_t dependencies;
+    };
+
+    Job _jobs[kMaxJobs] = {};
+    uint8_t _nbrOfJobs  = 0;
+    // one bit per job
+    uint32_t _startedJobs = 0;
+    uint32_t _doneJobs    = 0;
+
+    Mutex _mutex;
+    EventFlags _eventFlags;
+    Thread _thread;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,187 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file input_recorder.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Input recorder and replayer implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include "common/input_recorder.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "InputRecorder"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+void InputRecorder::start() {
+    core_util_critical_section_enter();
+    _timer.reset();
+    _timer.start();
+    _lastTime           = std::chrono::microseconds::zero();
+    _nbrOfRecords       = 0;
+    _isFull             = false;
+    _recording          = true;
+    core_util_critical_section_exit();
+}
+
+void InputRecorder::stop() { _recording = false; }
+
+bool InputRecorder::isRecording() const { return _recording; }
+
+std::chrono::microseconds InputRecorder::getElapsedTime() const {
+    return _timer.elapsed_time();
+}
+
+void InputRecorder::record(InputEvent inputEvent) {
+    if (!_recording) {
+        return;
+    }
+    core_util_critical_section_enter();
+    // restored if the input does not fit in the log
+    const uint16_t nbrOfRecords = _nbrOfRecords;
+
+    const std::chrono::microseconds currentTime = _timer.elapsed_time();
+    uint64_t delay = static_cast<uint64_t>((currentTime - _lastTime).count());
+    while (delay > kMaxDelay && _nbrOfRecords < kMaxRecords) {
+        _log[_nbrOfRecords] = encode(kMaxDelay, kIdleRecord);
+        _nbrOfRecords++;
+        delay -= kMaxDelay;
+    }
+    if (_nbrOfRecords < kMaxRecords) {
+        _log[_nbrOfRecords] =
+            encode(static_cast<uint32_t>(delay), static_cast<uint8_t>(inputEvent));
+        _nbrOfRecords++;
+        _lastTime = currentTime;
+    } else {
+        // the log ends with the last recorded input, without the idle records
+        // added for this one
+        _nbrOfRecords = nbrOfRecords;
+        _isFull       = true;
+        _recording    = false;
+    }
+    core_util_critical_section_exit();
+}
+
+const uint32_t* InputRecorder::getLog() const { return _log; }
+
+uint16_t InputRecorder::getNbrOfRecords() const { return _nbrOfRecords; }
+
+bool InputRecorder::isFull() const { return _isFull; }
+
+void InputRecorder::printLog() const {
+    tr_info("Input log: %d records%s",
+            _nbrOfRecords,
+            _isFull ? ", log full, recording stopped" : "");
+    // a few records per line, as a C array initializer
+    static constexpr uint8_t kRecordsPerLine = 6;
+    for (uint16_t index = 0; index < _nbrOfRecords; index += kRecordsPerLine) {
+        char line[kRecordsPerLine * 12 + 1] = {0};
+        size_t length                       = 0;
+        for (uint16_t record = index;
+             record < _nbrOfRecords && record < index + kRecordsPerLine;
+             record++) {
+            length += snprintf(
+                line + length, sizeof(line) - length, "0x%" PRIx32 ", ", _log[record]);
+        }
+        tr_info("%s", line);
+    }
+}
+
+uint8_t InputRecorder::getInput(uint32_t record) {
+    return static_cast<uint8_t>(record & ((1UL << kInputBits) - 1));
+}
+
+std::chrono::microseconds InputRecorder::getDelay(uint32_t record) {
+    return std::chrono::microseconds(record >> kInputBits);
+}
+
+uint32_t InputRecorder::encode(uint32_t delay, uint8_t input) {
+    return (delay << kInputBits) | input;
+}
+
+InputReplayer::InputReplayer(Callback<void(InputEvent)> inject) : _inject(inject) {}
+
+bool InputReplayer::start(const uint32_t* log,
+                          uint16_t nbrOfRecords,
+                          const std::chrono::microseconds& originTime) {
+    if (core_util_atomic_exchange_bool(&_running, true)) {
+        return false;
+    }
+    _log          = log;
+    _nbrOfRecords = nbrOfRecords;
+    _nextRecord   = 0;
+    _nextTime     = std::chrono::microseconds::zero();
+    _originTime   = originTime;
+    _eventFlags.clear(kEndFlag);
+    tr_info("Replaying %d input records", nbrOfRecords);
+
+    _timer.reset();
+    _timer.start();
+    scheduleNext();
+    return true;
+}
+
+void InputReplayer::stop() {
+    _timeout.detach();
+    core_util_atomic_store_bool(&_running, false);
+    _eventFlags.set(kEndFlag);
+}
+
+bool InputReplayer::isRunning() const { return core_util_atomic_load_bool(&_running); }
+
+void InputReplayer::waitForEnd() {
+    if (!isRunning()) {
+        return;
+    }
+    _eventFlags.wait_any(kEndFlag, osWaitForever, false);
+}
+
+void InputReplayer::scheduleNext() {
+    while (_nextRecord < _nbrOfRecords) {
+        const uint32_t record = _log[_nextRecord];
+        _nextTime += InputRecorder::getDelay(record);
+        if (InputRecorder::getInput(record) <
+            static_cast<uint8_t>(InputEvent::NbrOfInputEvents)) {
+            std::chrono::microseconds delay =
+                _nextTime - (_originTime + _timer.elapsed_time());
+            if (delay < std::chrono::microseconds::zero()) {
+                delay = std::chrono::microseconds::zero();
+            }
+            _timeout.attach(callback(this, &InputReplayer::onTimeout), delay);
+            return;
+        }
+        // idle record, only its time is replayed
+        _nextRecord++;
+    }
+    core_util_atomic_store_bool(&_running, false);
+    _eventFlags.set(kEndFlag);
+}
+
+void InputReplayer::onTimeout() {
+    const uint8_t input = InputRecorder::getInput(_log[_nextRecord]);
+    _nextRecord++;
+    _inject(static_cast<InputEvent>(input));
+    scheduleNext();
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,143 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file input_recorder.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Recording of timestamped inputs in a compact log and their replay
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// inputs of the bike system, as received from the joystick and the reset button
+enum class InputEvent : uint8_t {
+    JoystickUp = 0,
+    JoystickDown,
+    JoystickLeft,
+    JoystickRight,
+    ResetButton,
+    // long press of the reset button
+    TripResetButton,
+    NbrOfInputEvents
+};
+
+// the log is a sequence of 32-bit records: the time elapsed since the previous
+// record in us (bits 31..3) and the input (bits 2..0), the first one from the
+// start of the recorder. A longer time is split with idle records. The log
+// printed by printLog() can be copied into a table given to an InputReplayer.
+// Recording stops when the log is full, the log keeps the first inputs.
+class InputRecorder {
+   public:
+    static constexpr uint16_t kMaxRecords = MBED_CONF_APP_INPUT_LOG_SIZE;
+    static constexpr uint8_t kIdleRecord  = 7;
+
+    InputRecorder() = default;
+
+    // make the class non copyable
+    InputRecorder(InputRecorder&)            = delete;
+    InputRecorder& operator=(InputRecorder&) = delete;
+
+    // clear the log, times are measured from this call (the origin of the log)
+    void start();
+    void stop();
+    // false once stopped or once the log is full
+    bool isRecording() const;
+    // time elapsed since the origin of the log
+    std::chrono::microseconds getElapsedTime() const;
+
+    // may be called from ISR context, the input that does not fit stops recording
+    void record(InputEvent inputEvent);
+
+    const uint32_t* getLog() const;
+    uint16_t getNbrOfRecords() const;
+    // true if an input did not fit in the log
+    bool isFull() const;
+
+    void printLog() const;
+
+    // decoding of a record
+    static uint8_t getInput(uint32_t record);
+    static std::chrono::microseconds getDelay(uint32_t record);
+
+   private:
+    static constexpr uint8_t kInputBits = 3;
+    static constexpr uint32_t kMaxDelay = (1UL << (32 - kInputBits)) - 1;
+
+    static uint32_t encode(uint32_t delay, uint8_t input);
+
+    Timer _timer;
+    volatile bool _recording            = false;
+    std::chrono::microseconds _lastTime = std::chrono::microseconds::zero();
+    uint32_t _log[kMaxRecords]          = {};
+    uint16_t _nbrOfRecords              = 0;
+    bool _isFull                        = false;
+};
+
+// injects the inputs of a log with the recorded timing, from ISR context as the
+// joystick and the reset button do. The time of each input is computed from the
+// origin of the log, the error does not accumulate.
+class InputReplayer {
+   public:
+    explicit InputReplayer(Callback<void(InputEvent)> inject);
+
+    // make the class non copyable
+    InputReplayer(InputReplayer&)            = delete;
+    InputReplayer& operator=(InputReplayer&) = delete;
+
+    // originTime is the time already elapsed since the origin of the log (the
+    // start of the recorder of the replaying system), inputs whose time passed
+    // are injected at once and in order. The log must outlive the replay,
+    // returns false if a replay is running
+    bool start(const uint32_t* log,
+               uint16_t nbrOfRecords,
+               const std::chrono::microseconds& originTime =
+                   std::chrono::microseconds::zero());
+    void stop();
+
+    bool isRunning() const;
+    // wait for the last input of the log to be injected
+    void waitForEnd();
+
+   private:
+    void scheduleNext();
+    void onTimeout();
+
+    static constexpr uint32_t kEndFlag = (1UL << 0);
+
+    Callback<void(InputEvent)> _inject;
+    Timer _timer;
+    Timeout _timeout;
+    EventFlags _eventFlags;
+    const uint32_t* _log   = nullptr;
+    uint16_t _nbrOfRecords = 0;
+    uint16_t _nextRecord   = 0;
+    // time elapsed since the origin of the log when the replay started
+    std::chrono::microseconds _originTime = std::chrono::microseconds::zero();
+    // time of the next input, from the origin of the log
+    std::chrono::microseconds _nextTime = std::chrono::microseconds::zero();
+    volatile bool _running              = false;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,152 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file latency_stats.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Latency statistics implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/latency_stats.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "LatencyStats"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+void LatencyStats::record(const std::chrono::microseconds& latency) {
+    if (latency < _min) {
+        _min = latency;
+    }
+    if (latency > _max) {
+        _max = latency;
+    }
+    _total += latency.count();
+    _count++;
+    const uint32_t value =
+        latency.count() < 0 ? 0 : static_cast<uint32_t>(latency.count());
+    _buckets[getBucket(value)]++;
+}
+
+void LatencyStats::reset() {
+    _count = 0;
+    _min   = std::chrono::microseconds::max();
+    _max   = std::chrono::microseconds::zero();
+    _total = 0;
+    memset(_buckets, 0, sizeof(_buckets));
+}
+
+uint32_t LatencyStats::getCount() const { return _count; }
+
+std::chrono::microseconds LatencyStats::getMin() const {
+    return _count == 0 ? std::chrono::microseconds::zero() : _min;
+}
+
+std::chrono::microseconds LatencyStats::getMax() const { return _max; }
+
+std::chrono::microseconds LatencyStats::getAverage() const {
+    return std::chrono::microseconds(_count == 0 ? 0 : _total / _count);
+}
+
+std::chrono::microseconds LatencyStats::getPercentile(float percentile) const {
+    if (_count == 0) {
+        return std::chrono::microseconds::zero();
+    }
+    // rank of the sample, from 1 to _count
+    uint32_t rank = static_cast<uint32_t>(ceilf(percentile / 100.0f * _count));
+    if (rank < 1) {
+        rank = 1;
+    } else if (rank > _count) {
+        rank = _count;
+    }
+
+    uint32_t nbrOfSamples = 0;
+    uint16_t bucket       = 0;
+    for (; bucket < kNbrOfBuckets - 1; bucket++) {
+        nbrOfSamples += _buckets[bucket];
+        if (nbrOfSamples >= rank) {
+            break;
+        }
+    }
+    if (bucket == kOverflowBucket) {
+        return _max;
+    }
+    std::chrono::microseconds latency(getBucketUpperBound(bucket));
+    if (latency < _min) {
+        latency = _min;
+    } else if (latency > _max) {
+        latency = _max;
+    }
+    return latency;
+}
+
+void LatencyStats::printStats(const char* name) const {
+    tr_info("%s: %" PRIu32 " samples, min %" PRIu32 " us, avg %" PRIu32
+            " us, max %" PRIu32 " us",
+            name,
+            _count,
+            static_cast<uint32_t>(getMin().count()),
+            static_cast<uint32_t>(getAverage().count()),
+            static_cast<uint32_t>(getMax().count()));
+    // the number of samples above a percentile tells how much it can be trusted:
+    // with less than 1000 samples, p99.9 is the max
+    static constexpr uint8_t kNbrOfPercentiles              = 3;
+    static constexpr float kPercentiles[kNbrOfPercentiles]  = {50.0f, 99.0f, 99.9f};
+    static constexpr const char* kLabels[kNbrOfPercentiles] = {"p50", "p99", "p99.9"};
+    for (uint8_t index = 0; index < kNbrOfPercentiles; index++) {
+        const uint32_t rank =
+            static_cast<uint32_t>(ceilf(kPercentiles[index] / 100.0f * _count));
+        tr_info("%s: %s %" PRIu32 " us (%" PRIu32 " of %" PRIu32 " samples above)",
+                name,
+                kLabels[index],
+                static_cast<uint32_t>(getPercentile(kPercentiles[index]).count()),
+                rank < _count ? _count - rank : 0,
+                _count);
+    }
+}
+
+uint16_t LatencyStats::getBucket(uint32_t latency) {
+    if (latency < kNbrOfSubBuckets) {
+        return static_cast<uint16_t>(latency);
+    }
+    if (latency >= (1UL << kMaxExponent)) {
+        return kOverflowBucket;
+    }
+    // power of two below latency, the sub bucket is given by the next bits
+    const uint8_t exponent = static_cast<uint8_t>(31 - __builtin_clz(latency));
+    const uint8_t shift    = exponent - kSubBucketBits;
+    return static_cast<uint16_t>((exponent - kSubBucketBits + 1) * kNbrOfSubBuckets +
+                                 ((latency >> shift) & (kNbrOfSubBuckets - 1)));
+}
+
+uint32_t LatencyStats::getBucketUpperBound(uint16_t bucket) {
+    if (bucket < kNbrOfSubBuckets) {
+        return bucket;
+    }
+    const uint8_t shift      = bucket / kNbrOfSubBuckets - 1;
+    const uint32_t subBucket = bucket % kNbrOfSubBuckets;
+    return ((kNbrOfSubBuckets + subBucket + 1) << shift) - 1;
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,80 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file latency_stats.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Minimum, maximum and average of measured latencies
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// statistics of a response time (reset, event), updated in constant time. The
+// percentiles come from a log-linear histogram: 16 buckets per power of two, a
+// percentile is reported as the upper bound of its bucket (at most 6.25% above
+// the exact value), bounded by the exact min and max. A percentile in the
+// overflow bucket is reported as the max.
+class LatencyStats {
+   public:
+    LatencyStats() = default;
+
+    // make the class non copyable
+    LatencyStats(LatencyStats&)            = delete;
+    LatencyStats& operator=(LatencyStats&) = delete;
+
+    // called by a single thread
+    void record(const std::chrono::microseconds& latency);
+    void reset();
+
+    uint32_t getCount() const;
+    std::chrono::microseconds getMin() const;
+    std::chrono::microseconds getMax() const;
+    std::chrono::microseconds getAverage() const;
+    // percentile in [0, 100], for instance 99.9
+    std::chrono::microseconds getPercentile(float percentile) const;
+
+    void printStats(const char* name) const;
+
+   private:
+    static constexpr uint8_t kSubBucketBits   = 4;
+    static constexpr uint8_t kNbrOfSubBuckets = (1 << kSubBucketBits);
+    // latencies below 2^22 us (about 4 s) are bucketed, the others are counted in
+    // the overflow bucket
+    static constexpr uint8_t kMaxExponent = 22;
+    static constexpr uint16_t kOverflowBucket =
+        (kMaxExponent - kSubBucketBits + 1) * kNbrOfSubBuckets;
+    static constexpr uint16_t kNbrOfBuckets = kOverflowBucket + 1;
+
+    static uint16_t getBucket(uint32_t latency);
+    // largest latency of bucket
+    static uint32_t getBucketUpperBound(uint16_t bucket);
+
+    uint32_t _buckets[kNbrOfBuckets] = {};
+    uint32_t _count                  = 0;
+    std::chrono::microseconds _min   = std::chrono::microseconds::max();
+    std::chrono::microseconds _max   = std::chrono::microseconds::zero();
+    uint64_t _total                  = 0;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,135 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file mode_manager.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Operating modes implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/mode_manager.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "ModeManager"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+ModeManager::ModeManager(TimerWheel& timerWheel,
+                         const Speedometer& speedometer,
+                         Timer& timer,
+                         const std::chrono::seconds& pausedDelay,
+                         const std::chrono::seconds& parkedDelay)
+    : _timerWheel(timerWheel),
+      _speedometer(speedometer),
+      _timer(timer),
+      _pausedDelay(pausedDelay),
+      _parkedDelay(parkedDelay) {}
+
+bool ModeManager::start(const ModeTask* tasks, uint8_t nbrOfTasks) {
+    // the system starts riding only if an input already gave a speed
+    onActivity();
+    _mode = selectMode(std::chrono::microseconds::zero(), _speedometer.getCurrentSpeed());
+    tr_info("Mode %s", getModeName(_mode));
+
+    bool registered = true;
+    for (uint8_t index = 0; index < nbrOfTasks; index++) {
+        if (_nbrOfTasks == kMaxTasks) {
+            tr_error("Too many tasks, %s is not registered", tasks[index].name);
+            registered = false;
+            continue;
+        }
+        const TimerWheel::TimerId timerId = _timerWheel.addTimer(
+            tasks[index].name,
+            tasks[index].callback,
+            tasks[index].periods[static_cast<uint8_t>(_mode)],
+            tasks[index].offset);
+        if (timerId == TimerWheel::kInvalidTimerId) {
+            registered = false;
+            continue;
+        }
+        RegisteredTask& task = _tasks[_nbrOfTasks];
+        task.timerId         = timerId;
+        for (uint8_t mode = 0; mode < kNbrOfModes; mode++) {
+            task.periods[mode] = tasks[index].periods[mode];
+        }
+        _nbrOfTasks++;
+    }
+
+    const TimerWheel::TimerId timerId =
+        _timerWheel.addTimer("ModeManager",
+                             callback(this, &ModeManager::evaluate),
+                             kEvaluationPeriod,
+                             kEvaluationPeriod);
+    return registered && timerId != TimerWheel::kInvalidTimerId;
+}
+
+void ModeManager::onActivity() {
+    core_util_atomic_store_u64(&_lastActivityTime, _timer.elapsed_time().count());
+}
+
+void ModeManager::setMode(OperatingMode mode) {
+    if (mode == _mode) {
+        return;
+    }
+    tr_info("Mode %s -> %s", getModeName(_mode), getModeName(mode));
+    _mode = mode;
+    for (uint8_t index = 0; index < _nbrOfTasks; index++) {
+        _timerWheel.setPeriod(_tasks[index].timerId,
+                              _tasks[index].periods[static_cast<uint8_t>(mode)]);
+    }
+}
+
+OperatingMode ModeManager::getMode() const { return _mode; }
+
+TimerWheel::TimerId ModeManager::getTimerId(uint8_t taskIndex) const {
+    if (taskIndex >= _nbrOfTasks) {
+        return TimerWheel::kInvalidTimerId;
+    }
+    return _tasks[taskIndex].timerId;
+}
+
+OperatingMode ModeManager::selectMode(const std::chrono::microseconds& inactiveTime,
+                                      float speed) const {
+    if (inactiveTime >= _parkedDelay) {
+        return OperatingMode::Parked;
+    }
+    if (inactiveTime >= _pausedDelay || speed < kMovingSpeed) {
+        return OperatingMode::Paused;
+    }
+    return OperatingMode::Riding;
+}
+
+const char* ModeManager::getModeName(OperatingMode mode) {
+    static const char* const kModeNames[] = {"riding", "paused", "parked"};
+    if (mode >= OperatingMode::NbrOfModes) {
+        return "unknown";
+    }
+    return kModeNames[static_cast<uint8_t>(mode)];
+}
+
+void ModeManager::evaluate() {
+    const std::chrono::microseconds lastActivityTime(
+        core_util_atomic_load_u64(&_lastActivityTime));
+    setMode(selectMode(_timer.elapsed_time() - lastActivityTime,
+                       _speedometer.getCurrentSpeed()));
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,109 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file mode_manager.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Operating modes (riding, paused, parked) and per-mode task periods
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+#include "speedometer.hpp"
+#include "timer_wheel.hpp"
+
+namespace bike_computer {
+
+enum class OperatingMode : uint8_t { Riding = 0, Paused, Parked, NbrOfModes };
+
+static constexpr uint8_t kNbrOfModes = static_cast<uint8_t>(OperatingMode::NbrOfModes);
+
+// one entry of the task table: the task runs with the period of the current mode
+struct ModeTask {
+    const char* name;
+    Callback<void()> callback;
+    std::chrono::milliseconds periods[kNbrOfModes];
+    std::chrono::milliseconds offset;
+};
+
+// the mode is evaluated periodically on the timer wheel: riding while the bike
+// moves and inputs (pedal, gear, reset) are received, paused after pausedDelay
+// without input or when stopped, parked after parkedDelay without input. All
+// task periods are changed together from the thread of the wheel, between two
+// task runs.
+class ModeManager {
+   public:
+    static constexpr uint8_t kMaxTasks = 8;
+
+    ModeManager(TimerWheel& timerWheel,         // NOLINT(runtime/references)
+                const Speedometer& speedometer,
+                Timer& timer,                   // NOLINT(runtime/references)
+                const std::chrono::seconds& pausedDelay,
+                const std::chrono::seconds& parkedDelay);
+
+    // make the class non copyable
+    ModeManager(ModeManager&)            = delete;
+    ModeManager& operator=(ModeManager&) = delete;
+
+    // select the initial mode from the current speed, register the tasks with the
+    // timer wheel at their period in this mode and start evaluating the mode,
+    // returns false if a task could not be registered
+    bool start(const ModeTask* tasks, uint8_t nbrOfTasks);
+
+    // may be called from any thread
+    void onActivity();
+
+    // apply the periods of mode to all tasks (called by the mode evaluation)
+    void setMode(OperatingMode mode);
+    OperatingMode getMode() const;
+
+    // timer of the task number taskIndex of the table given to start()
+    TimerWheel::TimerId getTimerId(uint8_t taskIndex) const;
+
+    // mode corresponding to the time without input and to the current speed
+    OperatingMode selectMode(const std::chrono::microseconds& inactiveTime,
+                             float speed) const;
+
+    static const char* getModeName(OperatingMode mode);
+
+   private:
+    void evaluate();
+
+    static constexpr std::chrono::milliseconds kEvaluationPeriod = 1000ms;
+    // below this speed (km / h) the bike is considered as stopped
+    static constexpr float kMovingSpeed = 1.0f;
+
+    struct RegisteredTask {
+        TimerWheel::TimerId timerId;
+        std::chrono::milliseconds periods[kNbrOfModes];
+    };
+
+    TimerWheel& _timerWheel;
+    const Speedometer& _speedometer;
+    Timer& _timer;
+    const std::chrono::microseconds _pausedDelay;
+    const std::chrono::microseconds _parkedDelay;
+    RegisteredTask _tasks[kMaxTasks] = {};
+    uint8_t _nbrOfTasks              = 0;
+    OperatingMode _mode              = OperatingMode::Riding;
+    // expressed in us, written from any thread
+    volatile uint64_t _lastActivityTime = 0;
+};
+
+}  // namespace bike_computer
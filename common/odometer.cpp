@@ -0,0 +1,169 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file odometer.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Persistent odometer and trip counters implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/odometer.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "Odometer"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+// distance not saved yet that triggers a write (m)
+static constexpr uint32_t kWriteDistance = MBED_CONF_APP_ODOMETER_WRITE_DISTANCE;
+// minimal time between two writes, which bounds the flash wear
+static constexpr std::chrono::seconds kMinWriteInterval(
+    MBED_CONF_APP_ODOMETER_MIN_WRITE_INTERVAL);
+// below this speed, the bike is considered as stopped (km / h)
+static constexpr float kMinMovingSpeed = 1.0f;
+
+Odometer::Odometer(FlashKVStore& kvStore)
+    : _kvStore(kvStore),
+      _thread(osPriorityLow,
+              MBED_CONF_APP_ODOMETER_THREAD_STACK_SIZE,
+              nullptr,
+              "OdometerThread") {}
+
+void Odometer::start() {
+    Counters counters = {};
+    uint32_t size     = 0;
+    KVReturnCode rc   = _kvStore.get(kOdometerKey, &counters, sizeof(counters), size);
+    if (rc == KVReturnCode::Ok && size == sizeof(counters)) {
+        core_util_critical_section_enter();
+        _counters      = counters;
+        _savedOdometer = counters.odometer;
+        core_util_critical_section_exit();
+    } else if (rc != KVReturnCode::NotFound) {
+        tr_error("Cannot read the counters: %d", static_cast<int>(rc));
+    }
+    tr_info("Odometer: %" PRIu32 " m, trip A: %" PRIu32 " m, trip B: %" PRIu32 " m",
+            counters.odometer,
+            counters.trips[static_cast<uint8_t>(TripCounter::A)],
+            counters.trips[static_cast<uint8_t>(TripCounter::B)]);
+
+    _started = true;
+    _thread.start(callback(this, &Odometer::writeCounters));
+}
+
+void Odometer::stop() {
+    // no write is requested from now on
+    core_util_critical_section_enter();
+    const bool started = _started;
+    _started           = false;
+    core_util_critical_section_exit();
+    if (!started) {
+        return;
+    }
+    _eventFlags.set(kStopFlag);
+    _thread.join();
+}
+
+void Odometer::update(float traveledDistance,
+                      float currentSpeed,
+                      const std::chrono::microseconds& currentTime) {
+    // the distance given by the speedometer restarts from zero after a reset
+    const float distance = traveledDistance >= _lastTraveledDistance
+                               ? traveledDistance - _lastTraveledDistance
+                               : traveledDistance;
+    _lastTraveledDistance = traveledDistance;
+    _pendingDistance += distance * 1000.0f;
+    const uint32_t meters = static_cast<uint32_t>(_pendingDistance);
+    _pendingDistance -= static_cast<float>(meters);
+
+    const bool stopped = _moving && currentSpeed < kMinMovingSpeed;
+    _moving            = currentSpeed >= kMinMovingSpeed;
+
+    core_util_critical_section_enter();
+    _counters.odometer += meters;
+    for (uint8_t trip = 0; trip < static_cast<uint8_t>(TripCounter::NbrOfTrips); trip++) {
+        _counters.trips[trip] += meters;
+    }
+    // writes are coalesced: a write is needed once enough distance is not saved
+    // yet or when the bike stops, and it stays pending until it is allowed
+    const uint32_t unsavedDistance = _counters.odometer - _savedOdometer;
+    if (unsavedDistance >= kWriteDistance || (stopped && unsavedDistance > 0)) {
+        _writePending = true;
+    }
+    bool writeRequested = false;
+    if (_started && _writePending && currentTime - _lastWriteTime >= kMinWriteInterval) {
+        _savedOdometer = _counters.odometer;
+        _writePending  = false;
+        writeRequested = true;
+    }
+    core_util_critical_section_exit();
+
+    if (writeRequested) {
+        _lastWriteTime = currentTime;
+        _eventFlags.set(kWriteRequestFlag);
+    }
+}
+
+void Odometer::resetTrip(TripCounter trip) {
+    core_util_critical_section_enter();
+    _counters.trips[static_cast<uint8_t>(trip)] = 0;
+    _writePending                               = true;
+    core_util_critical_section_exit();
+}
+
+void Odometer::restoreTraveledDistance(float traveledDistance) {
+    _lastTraveledDistance = traveledDistance;
+}
+
+uint32_t Odometer::getOdometer() const { return _counters.odometer; }
+
+uint32_t Odometer::getTrip(TripCounter trip) const {
+    return _counters.trips[static_cast<uint8_t>(trip)];
+}
+
+uint32_t Odometer::getWriteCount() const { return _writeCount; }
+
+void Odometer::writeCounters() {
+    while (true) {
+        const uint32_t flags = _eventFlags.wait_any(kWriteRequestFlag | kStopFlag);
+        if ((flags & kWriteRequestFlag) == 0) {
+            return;
+        }
+
+        Counters counters;
+        core_util_critical_section_enter();
+        counters = _counters;
+        core_util_critical_section_exit();
+
+        // programming (and erasing during a compaction) stalls this low
+        // priority thread only
+        KVReturnCode rc = _kvStore.set(kOdometerKey, &counters, sizeof(counters));
+        if (rc != KVReturnCode::Ok) {
+            tr_error("Cannot write the counters: %d", static_cast<int>(rc));
+        } else {
+            _writeCount = _writeCount + 1;
+        }
+        if ((flags & kStopFlag) != 0) {
+            return;
+        }
+    }
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,105 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file odometer.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Lifetime odometer and trip A/B counters, persisted in flash with
+ *        coalesced and rate-limited writes
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "flash_kv_store.hpp"
+#include "mbed.h"
+
+namespace bike_computer {
+
+enum class TripCounter : uint8_t { A = 0, B, NbrOfTrips };
+
+class Odometer {
+   public:
+    // the key-value store must be initialized before start() is called
+    explicit Odometer(FlashKVStore& kvStore);  // NOLINT(runtime/references)
+
+    // make the class non copyable
+    Odometer(Odometer&)            = delete;
+    Odometer& operator=(Odometer&) = delete;
+
+    // load the counters from flash and start the thread writing them
+    void start();
+
+    // stop the thread writing the counters, a write already requested is done
+    // first
+    void stop();
+
+    // method called with the distance given by the speedometer (km, since its
+    // last reset) and the current speed (km / h), the counters are written when
+    // enough distance is not saved yet or when the bike stops, but never more
+    // often than the configured interval
+    void update(float traveledDistance,
+                float currentSpeed,
+                const std::chrono::microseconds& currentTime);
+
+    // method called for resetting a trip counter (saved with the next write)
+    void resetTrip(TripCounter trip);
+
+    // distance of the speedometer restored after a restart (already counted),
+    // to be called before the first update
+    void restoreTraveledDistance(float traveledDistance);
+
+    // distances expressed in m
+    uint32_t getOdometer() const;
+    uint32_t getTrip(TripCounter trip) const;
+
+    // number of writes since start
+    uint32_t getWriteCount() const;
+
+   private:
+    struct Counters {
+        uint32_t odometer;
+        uint32_t trips[static_cast<uint8_t>(TripCounter::NbrOfTrips)];
+    };
+
+    void writeCounters();
+
+    static constexpr uint32_t kWriteRequestFlag = (1UL << 0);
+    static constexpr uint32_t kStopFlag         = (1UL << 1);
+
+    FlashKVStore& _kvStore;
+    Thread _thread;
+    EventFlags _eventFlags;
+
+    // updated in critical sections, read by the write thread
+    Counters _counters      = {};
+    uint32_t _savedOdometer = 0;
+    bool _writePending      = false;
+
+    // only accessed by the thread calling update()
+    float _lastTraveledDistance              = 0.0f;
+    float _pendingDistance                   = 0.0f;
+    bool _moving                             = false;
+    std::chrono::microseconds _lastWriteTime = std::chrono::microseconds::zero();
+
+    bool _started                 = false;
+    volatile uint32_t _writeCount = 0;
+};
+
+}  // namespace bike_computer
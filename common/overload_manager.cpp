@@ -0,0 +1,104 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file overload_manager.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Overload manager implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/overload_manager.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "OverloadManager"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+OverloadManager::OverloadManager(TimerWheel& timerWheel,
+                                 const std::chrono::milliseconds& latenessThreshold)
+    : _timerWheel(timerWheel), _latenessThreshold(latenessThreshold) {}
+
+bool OverloadManager::addTask(TimerWheel::TimerId timerId, TaskCriticality criticality) {
+    if (timerId == TimerWheel::kInvalidTimerId || _nbrOfTasks == kMaxTasks) {
+        return false;
+    }
+    _tasks[_nbrOfTasks].timerId     = timerId;
+    _tasks[_nbrOfTasks].criticality = criticality;
+    _nbrOfTasks++;
+    return true;
+}
+
+bool OverloadManager::start() {
+    return _timerWheel.addTimer("OverloadManager",
+                                callback(this, &OverloadManager::evaluate),
+                                kEvaluationPeriod,
+                                kEvaluationPeriod) != TimerWheel::kInvalidTimerId;
+}
+
+uint8_t OverloadManager::getLevel() const { return _level; }
+
+uint32_t OverloadManager::getNbrOfOverloads() const { return _nbrOfOverloads; }
+
+void OverloadManager::onEvaluationPeriod(const std::chrono::microseconds& maxLateness) {
+    if (maxLateness > _latenessThreshold) {
+        _nbrOfOnTimeWindows = 0;
+        _nbrOfLateWindows++;
+        if (_nbrOfLateWindows >= kOverloadWindows && _level < kMaxLevel) {
+            tr_warn("Overload: lateness %" PRIu32 " us",
+                    static_cast<uint32_t>(maxLateness.count()));
+            if (_level == 0) {
+                _nbrOfOverloads++;
+            }
+            _nbrOfLateWindows = 0;
+            setLevel(_level + 1);
+        }
+    } else {
+        _nbrOfLateWindows = 0;
+        _nbrOfOnTimeWindows++;
+        if (_nbrOfOnTimeWindows >= kRecoveryWindows && _level > 0) {
+            _nbrOfOnTimeWindows = 0;
+            setLevel(_level - 1);
+        }
+    }
+}
+
+void OverloadManager::evaluate() { onEvaluationPeriod(_timerWheel.takeMaxLateness()); }
+
+void OverloadManager::setLevel(uint8_t level) {
+    tr_info("Overload level %d -> %d", _level, level);
+    _level = level;
+    for (uint8_t index = 0; index < _nbrOfTasks; index++) {
+        const ManagedTask& task = _tasks[index];
+        switch (task.criticality) {
+            case TaskCriticality::Degradable:
+                _timerWheel.setStretch(task.timerId, 1 << level);
+                break;
+            case TaskCriticality::Optional:
+                _timerWheel.setSuspended(task.timerId, level > 0);
+                break;
+            case TaskCriticality::Critical:
+            default:
+                break;
+        }
+    }
+}
+
+}  // namespace bike_computer
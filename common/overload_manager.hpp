@@ -0,0 +1,96 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file overload_manager.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Overload detection and degradation of the periodic tasks
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+#include "timer_wheel.hpp"
+
+namespace bike_computer {
+
+enum class TaskCriticality : uint8_t {
+    // never degraded
+    Critical = 0,
+    // run less often under overload (display, sensor refresh)
+    Degradable,
+    // not run at all under overload (logging)
+    Optional
+};
+
+// the largest lateness of the timer wheel runs is checked every evaluation
+// period. After kOverloadWindows late periods in a row the overload level is
+// raised: degradable tasks run every 2^level periods and optional tasks are
+// skipped. After kRecoveryWindows periods on time the level is lowered again.
+// The event driven paths (gear, pedal, reset) are not managed here, they gain
+// the time given back by the degraded tasks.
+class OverloadManager {
+   public:
+    static constexpr uint8_t kMaxTasks = 16;
+    static constexpr uint8_t kMaxLevel = 2;
+
+    OverloadManager(TimerWheel& timerWheel,  // NOLINT(runtime/references)
+                    const std::chrono::milliseconds& latenessThreshold);
+
+    // make the class non copyable
+    OverloadManager(OverloadManager&)            = delete;
+    OverloadManager& operator=(OverloadManager&) = delete;
+
+    // tasks must be registered with the timer wheel first
+    bool addTask(TimerWheel::TimerId timerId, TaskCriticality criticality);
+
+    // start evaluating the load, returns false if the evaluation timer could
+    // not be added
+    bool start();
+
+    // 0 when not overloaded
+    uint8_t getLevel() const;
+    uint32_t getNbrOfOverloads() const;
+
+    // update the level from the largest lateness of an evaluation period
+    void onEvaluationPeriod(const std::chrono::microseconds& maxLateness);
+
+   private:
+    void evaluate();
+    void setLevel(uint8_t level);
+
+    static constexpr std::chrono::milliseconds kEvaluationPeriod = 500ms;
+    static constexpr uint8_t kOverloadWindows                    = 2;
+    static constexpr uint8_t kRecoveryWindows                    = 6;
+
+    struct ManagedTask {
+        TimerWheel::TimerId timerId;
+        TaskCriticality criticality;
+    };
+
+    TimerWheel& _timerWheel;
+    const std::chrono::microseconds _latenessThreshold;
+    ManagedTask _tasks[kMaxTasks] = {};
+    uint8_t _nbrOfTasks           = 0;
+    uint8_t _level                = 0;
+    uint8_t _nbrOfLateWindows     = 0;
+    uint8_t _nbrOfOnTimeWindows   = 0;
+    uint32_t _nbrOfOverloads      = 0;
+};
+
+}  // namespace bike_computer
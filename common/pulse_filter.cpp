@@ -0,0 +1,88 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file pulse_filter.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Pulse debouncing and period measurement implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/pulse_filter.hpp"
+
+namespace bike_computer {
+
+PulseFilter::PulseFilter(const std::chrono::microseconds& debounceTime,
+                         const std::chrono::microseconds& stopTimeout)
+    : _debounceTime(static_cast<uint32_t>(debounceTime.count())),
+      _stopTimeout(static_cast<uint32_t>(stopTimeout.count())) {}
+
+bool PulseFilter::onEdge(uint32_t timestamp) {
+    const uint32_t pulseCount = _pulseCount;
+    if (pulseCount == 0 || _isStopped) {
+        // first edge, or first edge after a stop: no period to measure yet
+        _lastTimestamp = timestamp;
+        _pulseCount    = pulseCount + 1;
+        _isStopped     = false;
+        return false;
+    }
+
+    // unsigned arithmetic handles the wrap around of the timestamps
+    const uint32_t period = timestamp - _lastTimestamp;
+    if (period < _debounceTime) {
+        _bounceCount = _bounceCount + 1;
+        return false;
+    }
+    _lastTimestamp = timestamp;
+    _lastPeriod    = period;
+    _pulseCount    = pulseCount + 1;
+    return true;
+}
+
+bool PulseFilter::checkStopped(uint32_t timestamp) {
+    bool isStopped = false;
+    // the edges are accepted in ISR context
+    core_util_critical_section_enter();
+    if (_pulseCount != 0 && !_isStopped &&
+        timestamp - _lastTimestamp >= _stopTimeout) {
+        _isStopped  = true;
+        _lastPeriod = 0;
+        isStopped   = true;
+    }
+    core_util_critical_section_exit();
+    return isStopped;
+}
+
+std::chrono::microseconds PulseFilter::getLastPeriod() const {
+    return std::chrono::microseconds(_lastPeriod);
+}
+
+uint32_t PulseFilter::getPulseCount() const { return _pulseCount; }
+
+uint32_t PulseFilter::getBounceCount() const { return _bounceCount; }
+
+void PulseFilter::reset() {
+    core_util_critical_section_enter();
+    _lastTimestamp = 0;
+    _lastPeriod    = 0;
+    _pulseCount    = 0;
+    _bounceCount   = 0;
+    _isStopped     = false;
+    core_util_critical_section_exit();
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,77 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file pulse_filter.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Debouncing and rotation period measurement of reed/Hall sensor
+ *        pulses, from edge timestamps (no hardware access)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+class PulseFilter {
+   public:
+    // edges closer than debounceTime to the last accepted one are bounces, no
+    // accepted edge for stopTimeout means that the crank stopped turning
+    PulseFilter(const std::chrono::microseconds& debounceTime,
+                const std::chrono::microseconds& stopTimeout);
+
+    // make the class non copyable
+    PulseFilter(PulseFilter&)            = delete;
+    PulseFilter& operator=(PulseFilter&) = delete;
+
+    // method called from ISR context with the timestamp of an edge (us, the
+    // timestamp may wrap around), constant time, returns true when a new
+    // rotation period is available
+    bool onEdge(uint32_t timestamp);
+
+    // method called periodically with the current timestamp (us), returns true
+    // once when no edge was accepted for the stop timeout, the last period is
+    // then cleared and the next edge restarts the measurement
+    bool checkStopped(uint32_t timestamp);
+
+    // last measured rotation period (zero if none yet or stopped), may be called
+    // from any thread
+    std::chrono::microseconds getLastPeriod() const;
+
+    // number of accepted pulses and of rejected (bounce) edges
+    uint32_t getPulseCount() const;
+    uint32_t getBounceCount() const;
+
+    void reset();
+
+   private:
+    const uint32_t _debounceTime;
+    const uint32_t _stopTimeout;
+
+    // written in ISR context only
+    volatile uint32_t _lastTimestamp = 0;
+    volatile uint32_t _lastPeriod    = 0;
+    volatile uint32_t _pulseCount    = 0;
+    volatile uint32_t _bounceCount   = 0;
+    volatile bool _isStopped         = false;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,81 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file resumable_task.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Resumable task implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include "common/resumable_task.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "ResumableTask"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+ResumableTask::ResumableTask(EventQueue& eventQueue, const char* name)
+    : _eventQueue(eventQueue), _name(name) {}
+
+bool ResumableTask::start(Callback<TaskStep(uint8_t)> step, Callback<void()> onDone) {
+    if (core_util_atomic_exchange_bool(&_running, true)) {
+        _nbrOfOverruns++;
+        return false;
+    }
+    _step      = step;
+    _onDone    = onDone;
+    _stepIndex = 0;
+    if (_eventQueue.call(callback(this, &ResumableTask::resume)) == 0) {
+        tr_error("Cannot start %s", _name);
+        core_util_atomic_store_bool(&_running, false);
+        return false;
+    }
+    return true;
+}
+
+bool ResumableTask::isRunning() const { return core_util_atomic_load_bool(&_running); }
+
+uint32_t ResumableTask::getNbrOfOverruns() const { return _nbrOfOverruns; }
+
+void ResumableTask::resume() {
+    const TaskStep taskStep = _step(_stepIndex);
+    _stepIndex++;
+    if (taskStep.isDone) {
+        core_util_atomic_store_bool(&_running, false);
+        if (_onDone) {
+            _onDone();
+        }
+        return;
+    }
+
+    const int eventId =
+        (taskStep.delay == std::chrono::milliseconds::zero())
+            ? _eventQueue.call(callback(this, &ResumableTask::resume))
+            : _eventQueue.call_in(taskStep.delay, callback(this, &ResumableTask::resume));
+    if (eventId == 0) {
+        // the next run starts again from the first step
+        tr_error("Cannot resume %s at step %d", _name, _stepIndex);
+        core_util_atomic_store_bool(&_running, false);
+    }
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,81 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file resumable_task.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Multi-step operations run on an EventQueue, yielding the thread between steps
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// returned by each step of a resumable task
+struct TaskStep {
+    bool isDone;
+    // delay before the next step, the thread handles other events in the meantime
+    std::chrono::milliseconds delay;
+
+    static TaskStep waitFor(const std::chrono::milliseconds& waitDuration) {
+        return {false, waitDuration};
+    }
+    static TaskStep next() { return {false, std::chrono::milliseconds::zero()}; }
+    static TaskStep done() { return {true, std::chrono::milliseconds::zero()}; }
+};
+
+// a multi-step operation (trigger, wait, read) written as a step function called
+// with the index of the step to run: the function switches on the index and
+// returns after each step. The steps are run by the thread dispatching the event
+// queue, which never blocks during the waits. The state kept between two steps
+// lives in the object bound to the step function, no frame is allocated.
+class ResumableTask {
+   public:
+    ResumableTask(EventQueue& eventQueue,  // NOLINT(runtime/references)
+                  const char* name);
+
+    // make the class non copyable
+    ResumableTask(ResumableTask&)            = delete;
+    ResumableTask& operator=(ResumableTask&) = delete;
+
+    // run step from step index 0 until it returns done, then call onDone on the
+    // thread of the event queue. Returns false if the task is still running (an
+    // overrun) or if the first step cannot be posted.
+    bool start(Callback<TaskStep(uint8_t)> step, Callback<void()> onDone);
+
+    bool isRunning() const;
+    uint32_t getNbrOfOverruns() const;
+
+   private:
+    void resume();
+
+    EventQueue& _eventQueue;
+    const char* _name;
+    Callback<TaskStep(uint8_t)> _step;
+    Callback<void()> _onDone;
+    uint8_t _stepIndex      = 0;
+    volatile bool _running  = false;
+    uint32_t _nbrOfOverruns = 0;
+};
+
+}  // namespace bike_computer
@@ -0,0 +1,156 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file retained_ride_state.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Retained ride state implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/retained_ride_state.hpp"
+
+#include <cstring>
+
+#include "MbedCRC.h"
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "RetainedRideState"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+RetainedRideState& RetainedRideState::getInstance() {
+    static RetainedRideState retainedRideState;
+    return retainedRideState;
+}
+
+RetainedRideState::RetainedRideState() {
+#if defined(TARGET_STM32H7)
+    // the backup SRAM is not initialized at boot and is kept across resets
+    HAL_PWR_EnableBkUpAccess();
+    __HAL_RCC_BKPRAM_CLK_ENABLE();
+    _records    = reinterpret_cast<Record*>(D3_BKPSRAM_BASE);
+    _missedTask = reinterpret_cast<MissedTaskRecord*>(D3_BKPSRAM_BASE +
+                                                      kNbrOfRecords * sizeof(Record));
+#else
+    // only kept across restarts of the bike system
+    static Record records[kNbrOfRecords];
+    static MissedTaskRecord missedTask;
+    _records    = records;
+    _missedTask = &missedTask;
+#endif  // defined(TARGET_STM32H7)
+}
+
+void RetainedRideState::save(const RideState& state) {
+    ScopedLock<Mutex> lock(_mutex);
+    // the record following the latest one is overwritten
+    const uint8_t latest = findLatest();
+    const uint8_t index  = latest == kNbrOfRecords ? 0 : (latest + 1) % kNbrOfRecords;
+
+    Record& record  = _records[index];
+    record.magic    = kMagic;
+    record.sequence = latest == kNbrOfRecords ? 1 : _records[latest].sequence + 1;
+    record.state    = state;
+    memset(record.state.reserved, 0, sizeof(record.state.reserved));
+    record.crc = computeCRC(record);
+    flush(&record, sizeof(record));
+}
+
+bool RetainedRideState::load(RideState& state) {
+    ScopedLock<Mutex> lock(_mutex);
+    const uint8_t latest = findLatest();
+    if (latest == kNbrOfRecords) {
+        return false;
+    }
+    state = _records[latest].state;
+    return true;
+}
+
+void RetainedRideState::invalidate() {
+    ScopedLock<Mutex> lock(_mutex);
+    for (uint8_t index = 0; index < kNbrOfRecords; index++) {
+        _records[index].magic = 0;
+        flush(&_records[index], sizeof(Record));
+    }
+}
+
+void RetainedRideState::saveMissedTask(uint8_t taskId) {
+    ScopedLock<Mutex> lock(_mutex);
+    _missedTask->magic  = kMissedTaskMagic;
+    _missedTask->taskId = taskId;
+    _missedTask->check  = ~static_cast<uint32_t>(taskId);
+    flush(_missedTask, sizeof(MissedTaskRecord));
+}
+
+bool RetainedRideState::takeMissedTask(uint8_t& taskId) {
+    ScopedLock<Mutex> lock(_mutex);
+    const bool isValid = _missedTask->magic == kMissedTaskMagic &&
+                         _missedTask->check == ~_missedTask->taskId &&
+                         _missedTask->taskId <= UINT8_MAX;
+    if (isValid) {
+        taskId = static_cast<uint8_t>(_missedTask->taskId);
+    }
+    _missedTask->magic = 0;
+    flush(_missedTask, sizeof(MissedTaskRecord));
+    return isValid;
+}
+
+void RetainedRideState::clearMissedTask() {
+    ScopedLock<Mutex> lock(_mutex);
+    _missedTask->magic = 0;
+    flush(_missedTask, sizeof(MissedTaskRecord));
+}
+
+uint32_t RetainedRideState::computeCRC(const Record& record) {
+    mbed::MbedCRC<POLY_32BIT_ANSI, 32> crc;
+    uint32_t result = 0;
+    crc.compute(&record, offsetof(Record, crc), &result);
+    return result;
+}
+
+uint8_t RetainedRideState::findLatest() const {
+    uint8_t latest = kNbrOfRecords;
+    for (uint8_t index = 0; index < kNbrOfRecords; index++) {
+        const Record& record = _records[index];
+        if (isValid(record) &&
+            (latest == kNbrOfRecords ||
+             static_cast<int32_t>(record.sequence - _records[latest].sequence) > 0)) {
+            latest = index;
+        }
+    }
+    return latest;
+}
+
+bool RetainedRideState::isValid(const Record& record) const {
+    return record.magic == kMagic && record.crc == computeCRC(record);
+}
+
+void RetainedRideState::flush(const void* data, size_t size) {
+#if defined(TARGET_STM32H7)
+    // the backup SRAM is cacheable, the record must reach it before a reset
+    SCB_CleanDCache_by_Addr(
+        reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(data) & ~0x1FU),
+        size + 32);
+#else
+    (void)data;
+    (void)size;
+#endif  // defined(TARGET_STM32H7)
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,105 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file retained_ride_state.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Ride state kept in retained RAM across restarts and software resets
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// state restored when the bike system restarts
+struct RideState {
+    // expressed in km, since the last reset
+    float distance;
+    // expressed in ms
+    uint32_t pedalRotationTime;
+    uint8_t gear;
+    uint8_t reserved[3];
+};
+
+// the ride state is kept in RAM that is not initialized at boot (backup SRAM on
+// STM32H7), it survives a restart of the bike system and a software or watchdog
+// reset, not a power loss. Two records protected by a CRC are written in turn,
+// a reset while saving leaves the previous record valid.
+class RetainedRideState {
+   public:
+    static RetainedRideState& getInstance();
+
+    // make the class non copyable
+    RetainedRideState(RetainedRideState&)            = delete;
+    RetainedRideState& operator=(RetainedRideState&) = delete;
+
+    // may be called from any thread, not from an ISR
+    void save(const RideState& state);
+
+    // most recent valid state, returns false if there is none
+    bool load(RideState& state);  // NOLINT(runtime/references)
+
+    // the next load returns false until a state is saved
+    void invalidate();
+
+    // id of the task that missed its heartbeat before a watchdog reset, kept in
+    // its own record next to the ride state
+    void saveMissedTask(uint8_t taskId);
+    // returns false if no task id was saved, the saved id is cleared
+    bool takeMissedTask(uint8_t& taskId);  // NOLINT(runtime/references)
+    // the saved id is cleared when the task recovers before the reset
+    void clearMissedTask();
+
+   private:
+    RetainedRideState();
+
+    struct Record {
+        uint32_t magic;
+        uint32_t sequence;
+        RideState state;
+        uint32_t crc;
+    };
+
+    struct MissedTaskRecord {
+        uint32_t magic;
+        uint32_t taskId;
+        // complement of taskId
+        uint32_t check;
+    };
+
+    static constexpr uint8_t kNbrOfRecords     = 2;
+    static constexpr uint32_t kMagic           = 0x52494445;
+    static constexpr uint32_t kMissedTaskMagic = 0x4D495353;
+
+    static uint32_t computeCRC(const Record& record);
+    // index of the valid record saved last, kNbrOfRecords if none is valid
+    uint8_t findLatest() const;
+    bool isValid(const Record& record) const;
+    static void flush(const void* data, size_t size);
+
+    Mutex _mutex;
+    // in retained RAM
+    Record* _records;
+    MissedTaskRecord* _missedTask;
+};
+
+}  // namespace bike_computer
@@ -24,9 +24,15 @@
 
 #include "common/sensor_device.hpp"
 
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "SensorDevice"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
 namespace bike_computer {
 
-SensorDevice::SensorDevice() : _hdc1000(PD_13, PD_12, PC_6) {}
+SensorDevice::SensorDevice() : _hdc1000(PD_13, PD_12, PC_6), _i2c(PD_13, PD_12) {}
 
 bool SensorDevice::init() { return _hdc1000.probe(); }
 
@@ -34,4 +40,43 @@ float SensorDevice::readHumidity() { return _hdc1000.getHumidity(); }
 
 float SensorDevice::readTemperature() { return _hdc1000.getTemperature(); }
 
+TaskStep SensorDevice::readTemperatureStep(uint8_t step) {
+    switch (step) {
+        case TriggerConversion: {
+            _isLastTemperatureValid = false;
+            // writing the register pointer starts the conversion
+            const char registerPointer = kTemperatureRegister;
+            if (_i2c.write(kI2CAddress, &registerPointer, 1) != 0) {
+                tr_error("Cannot trigger the temperature conversion");
+                return TaskStep::done();
+            }
+            return TaskStep::waitFor(kConversionTime);
+        }
+
+        case ReadResult:
+        default: {
+            char data[2] = {0};
+            if (_i2c.read(kI2CAddress, data, sizeof(data)) != 0) {
+                tr_error("Cannot read the temperature");
+                return TaskStep::done();
+            }
+            // big endian, T = raw / 2^16 * 165 - 40 (datasheet)
+            const uint16_t rawTemperature = static_cast<uint16_t>(
+                (static_cast<uint8_t>(data[0]) << 8) | static_cast<uint8_t>(data[1]));
+            _lastTemperature =
+                (static_cast<float>(rawTemperature) / 65536.0f) * 165.0f - 40.0f;
+            _isLastTemperatureValid = true;
+            return TaskStep::done();
+        }
+    }
+}
+
+bool SensorDevice::getLastTemperature(float& temperature) const {
+    if (!_isLastTemperatureValid) {
+        return false;
+    }
+    temperature = _lastTemperature;
+    return true;
+}
+
 }  // namespace bike_computer
@@ -24,8 +24,11 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "hdc1000.hpp"
 #include "mbed.h"
+#include "resumable_task.hpp"
 
 namespace bike_computer {
 
@@ -41,9 +44,29 @@ class SensorDevice {
     float readTemperature();
     float readHumidity();
 
+    // steps of a temperature read run by a ResumableTask: trigger the conversion,
+    // wait for it and read the result, without blocking the calling thread
+    TaskStep readTemperatureStep(uint8_t step);
+    // result of the last temperature read done by readTemperatureStep(), returns
+    // false if it failed on the bus
+    bool getLastTemperature(float& temperature) const;  // NOLINT(runtime/references)
+
    private:
+    enum ReadStep : uint8_t { TriggerConversion = 0, ReadResult };
+
+    // 8-bit address expected by I2C
+    static constexpr int kI2CAddress           = (0x40 << 1);
+    static constexpr char kTemperatureRegister = 0x00;
+    // the sensor acquires the temperature and then the humidity (MODE=1 at reset),
+    // 14-bit conversions (6.35 ms + 6.5 ms) with margin
+    static constexpr std::chrono::milliseconds kConversionTime = 15ms;
+
     // data members
     advembsof::HDC1000 _hdc1000;
+    // on the bus of the driver, used by the steps of the temperature read
+    I2C _i2c;
+    float _lastTemperature       = 0.0f;
+    bool _isLastTemperatureValid = false;
 };
 
 }  // namespace bike_computer
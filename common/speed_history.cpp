@@ -0,0 +1,62 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file speed_history.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Speed history implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/speed_history.hpp"
+
+namespace bike_computer {
+
+static constexpr float kSampleResolution = 10.0f;
+static constexpr float kMaxSample        = 65535.0f;
+
+void SpeedHistory::push(float speed) {
+    float sample = speed * kSampleResolution + 0.5f;
+    if (sample < 0.0f) {
+        sample = 0.0f;
+    } else if (sample > kMaxSample) {
+        sample = kMaxSample;
+    }
+    uint32_t count = _count;
+    if (core_util_atomic_exchange_bool(&_isResetRequested, false)) {
+        count = 0;
+        core_util_atomic_store_u32(&_count, 0);
+        core_util_atomic_incr_u32(&_nbrOfResets, 1);
+    }
+    _samples[count % kCapacity] = static_cast<uint16_t>(sample);
+    // publish the sample only once it is written
+    core_util_atomic_store_u32(&_count, count + 1);
+}
+
+uint32_t SpeedHistory::getCount() const { return core_util_atomic_load_u32(&_count); }
+
+uint32_t SpeedHistory::getNbrOfResets() const {
+    return core_util_atomic_load_u32(&_nbrOfResets);
+}
+
+float SpeedHistory::getSample(uint32_t sampleIndex) const {
+    return static_cast<float>(_samples[sampleIndex % kCapacity]) / kSampleResolution;
+}
+
+void SpeedHistory::reset() { core_util_atomic_store_bool(&_isResetRequested, true); }
+
+}  // namespace bike_computer
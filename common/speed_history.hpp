@@ -0,0 +1,68 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file speed_history.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Fixed-size circular buffer of speed samples
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// written by one thread, may be read by another one: a reader lagging by more
+// than kCapacity samples must start again from getCount() - kCapacity
+class SpeedHistory {
+   public:
+    static constexpr uint32_t kCapacity = 128;
+
+    SpeedHistory() = default;
+
+    // make the class non copyable
+    SpeedHistory(SpeedHistory&)            = delete;
+    SpeedHistory& operator=(SpeedHistory&) = delete;
+
+    // add a sample (expressed in km / h)
+    void push(float speed);
+
+    // total number of samples pushed since creation or reset
+    uint32_t getCount() const;
+
+    // number of resets applied, a reader redraws all samples when it changes
+    uint32_t getNbrOfResets() const;
+
+    // sample number sampleIndex (0 is the first sample ever pushed), only the
+    // last kCapacity samples are available
+    float getSample(uint32_t sampleIndex) const;
+
+    // may be called from any thread, the history is emptied by the writer on the
+    // next push
+    void reset();
+
+   private:
+    // samples are stored in 1/10 km / h
+    uint16_t _samples[kCapacity]    = {0};
+    volatile uint32_t _count        = 0;
+    volatile uint32_t _nbrOfResets  = 0;
+    volatile bool _isResetRequested = false;
+};
+
+}  // namespace bike_computer
@@ -39,42 +39,68 @@ namespace bike_computer {
 
 Speedometer::Speedometer(Timer& timer) : _timer(timer) {
     // update _lastTime
-    _lastTime = _timer.elapsed_time();
+    _lastTime = getCurrentTime();
 }
 
 void Speedometer::setCurrentRotationTime(
     const std::chrono::milliseconds& currentRotationTime) {
+    ScopedLock<Mutex> lock(_writerMutex);
     if (_pedalRotationTime != currentRotationTime) {
-        // compute distance before changing the rotation time
-        computeDistance();
-
         // change pedal rotation time
         _pedalRotationTime = currentRotationTime;
 
-        // compute speed with the new pedal rotation time
-        computeSpeed();
+        // integrate the distance at the previous speed and publish the new speed
+        publish(computeSpeed());
     }
 }
 
 void Speedometer::setGearSize(uint8_t gearSize) {
+    ScopedLock<Mutex> lock(_writerMutex);
     if (_gearSize != gearSize) {
-        // compute distance before chaning the gear size
-        computeDistance();
-        // Comment
         //  change gear size
         _gearSize = gearSize;
 
-        // compute speed with the new gear size
-        computeSpeed();
+        // integrate the distance at the previous speed and publish the new speed
+        publish(computeSpeed());
+    }
+}
+
+bool Speedometer::setDrivetrainProfile(const DrivetrainProfile& profile) {
+    ScopedLock<Mutex> lock(_writerMutex);
+    if (!_drivetrain.setProfile(profile)) {
+        tr_error("Invalid drivetrain profile");
+        return false;
     }
+    _chainring = 0;
+
+    // integrate the distance at the previous speed and publish the new speed
+    publish(computeSpeed());
+    return true;
 }
 
+const Drivetrain& Speedometer::getDrivetrain() const { return _drivetrain; }
+
 float Speedometer::getCurrentSpeed() const { return _currentSpeed; }
 
-float Speedometer::getDistance() {
-    // make sure to update the distance traveled
-    computeDistance();
-    return _totalDistance;
+float Speedometer::getDistance() const {
+    // copy a consistent state, retrying if a writer published in between
+    double totalDistance;
+    float currentSpeed;
+    std::chrono::microseconds lastTime;
+    uint32_t sequence;
+    do {
+        sequence      = core_util_atomic_load_u32(&_sequence);
+        totalDistance = _totalDistance;
+        currentSpeed  = _currentSpeed;
+        lastTime      = _lastTime;
+        // the copies must be done before the sequence is read again (the atomic
+        // load only orders the accesses that follow it)
+        MBED_BARRIER();
+    } while ((sequence & 1) != 0 || sequence != core_util_atomic_load_u32(&_sequence));
+
+    // extrapolate to now, nothing is written
+    return static_cast<float>(totalDistance +
+                              computeDistance(currentSpeed, getCurrentTime() - lastTime));
 }
 
 void Speedometer::reset() {
@@ -83,19 +109,47 @@ void Speedometer::reset() {
         _callback();
     }
 #endif  // defined(MBED_TEST_MODE)
-    _totalDistanceMutex.lock();
-    _totalDistance = 0.0f;
-    _currentSpeed  = 0;
-    _totalDistanceMutex.unlock();
-    _lastTime = _timer.elapsed_time();
+    ScopedLock<Mutex> lock(_writerMutex);
+    const std::chrono::microseconds currentTime = getCurrentTime();
+    core_util_critical_section_enter();
+    _sequence      = _sequence + 1;
+    _totalDistance = 0.0;
+    _currentSpeed  = 0.0f;
+    _lastTime      = currentTime;
+    _sequence      = _sequence + 1;
+    core_util_critical_section_exit();
+}
+
+void Speedometer::restoreDistance(float distance) {
+    ScopedLock<Mutex> lock(_writerMutex);
+    const std::chrono::microseconds currentTime = getCurrentTime();
+    core_util_critical_section_enter();
+    _sequence      = _sequence + 1;
+    _totalDistance = distance;
+    _lastTime      = currentTime;
+    _sequence      = _sequence + 1;
+    core_util_critical_section_exit();
 }
 
 #if defined(MBED_TEST_MODE)
 uint8_t Speedometer::getGearSize() const { return _gearSize; }
 
-float Speedometer::getWheelCircumference() const { return kWheelCircumference; }
+float Speedometer::getWheelCircumference() const {
+    return _drivetrain.getProfile().wheelCircumference;
+}
+
+float Speedometer::getTraySize() const {
+    return _drivetrain.getProfile().chainrings[_chainring];
+}
 
-float Speedometer::getTraySize() const { return kTraySize; }
+void Speedometer::setChainring(uint8_t chainring) {
+    ScopedLock<Mutex> lock(_writerMutex);
+    if (_chainring != chainring &&
+        chainring < _drivetrain.getProfile().nbrOfChainrings) {
+        _chainring = chainring;
+        publish(computeSpeed());
+    }
+}
 
 std::chrono::milliseconds Speedometer::getCurrentPedalRotationTime() const {
     return _pedalRotationTime;
@@ -103,45 +157,67 @@ std::chrono::milliseconds Speedometer::getCurrentPedalRotationTime() const {
 
 void Speedometer::setOnResetCallback(Callback<void()> callback) { _callback = callback; }
 
-#endif  // defined(MBED_TEST_MODE)
+void Speedometer::setTimeSource(Callback<std::chrono::microseconds()> timeSource) {
+    ScopedLock<Mutex> lock(_writerMutex);
+    _timeSource = timeSource;
+    _lastTime   = getCurrentTime();
+}
 
-void Speedometer::computeSpeed() {
-    // For computing the speed given a rear gear (braquet), one must divide the size of
-    // the tray (plateau) by the size of the rear gear (pignon arrière), and then multiply
-    // the result by the circumference of the wheel. Example: tray = 50, rear gear = 15.
-    // Distance run with one pedal turn (wheel circumference = 2.10 m) = 50/15 * 2.1 m
-    // = 6.99m If you ride at 80 pedal turns / min, you run a distance of 6.99 * 80 / min
-    // ~= 560 m / min = 33.6 km/h
+#endif  // defined(MBED_TEST_MODE)
 
-    float gearRatio   = static_cast<float>(kTraySize) / static_cast<float>(_gearSize);
-    float distPerTurn = kWheelCircumference * gearRatio;
-    _currentSpeed =
-        distPerTurn * 3600.0f /
-        std::chrono::duration_cast<std::chrono::milliseconds>(_pedalRotationTime).count();
+std::chrono::microseconds Speedometer::getCurrentTime() const {
+#if defined(MBED_TEST_MODE)
+    if (_timeSource) {
+        return _timeSource();
+    }
+#endif  // defined(MBED_TEST_MODE)
+    return _timer.elapsed_time();
 }
 
-void Speedometer::computeDistance() {
+float Speedometer::computeSpeed() const {
     // For computing the speed given a rear gear (braquet), one must divide the size of
     // the tray (plateau) by the size of the rear gear (pignon arrière), and then multiply
     // the result by the circumference of the wheel. Example: tray = 50, rear gear = 15.
     // Distance run with one pedal turn (wheel circumference = 2.10 m) = 50/15 * 2.1 m
     // = 6.99m If you ride at 80 pedal turns / min, you run a distance of 6.99 * 80 / min
-    // ~= 560 m / min = 33.6 km/h. We then multiply the speed by the time for getting the
-    // distance traveled.
-
-    std::chrono::microseconds currentTime = _timer.elapsed_time();
-    auto elapsedTime =
-        std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - _lastTime);
+    // ~= 560 m / min = 33.6 km/h
+    // The distance per pedal turn is precomputed by the drivetrain for each cog.
 
-    float distance = _currentSpeed * elapsedTime.count() / 3600000.0f;
+    if (_pedalRotationTime.count() <= 0) {
+        // the crank stopped turning
+        return 0.0f;
+    }
+    float distPerTurn = _drivetrain.getDistancePerTurn(_chainring, _gearSize);
+    return distPerTurn * 3600.0f /
+           std::chrono::duration_cast<std::chrono::milliseconds>(_pedalRotationTime)
+               .count();
+}
 
-    // update distance traveled
-    _totalDistanceMutex.lock();
-    _totalDistance += distance;
-    _totalDistanceMutex.unlock();
+float Speedometer::computeDistance(float speed,
+                                   const std::chrono::microseconds& elapsedTime) {
+    // We multiply the speed (km / h) by the time for getting the distance
+    // traveled (km).
+    if (elapsedTime.count() <= 0) {
+        return 0.0f;
+    }
+    return speed * static_cast<float>(elapsedTime.count()) / 3.6e9f;
+}
 
-    // update last time
-    _lastTime = currentTime;
+void Speedometer::publish(float currentSpeed) {
+    // the distance traveled at the previous speed is integrated here, by the
+    // writers only
+    const std::chrono::microseconds currentTime = getCurrentTime();
+    const double totalDistance =
+        _totalDistance + computeDistance(_currentSpeed, currentTime - _lastTime);
+
+    // the critical section is short and readers never wait for a writer
+    core_util_critical_section_enter();
+    _sequence      = _sequence + 1;
+    _totalDistance = totalDistance;
+    _currentSpeed  = currentSpeed;
+    _lastTime      = currentTime;
+    _sequence      = _sequence + 1;
+    core_util_critical_section_exit();
 }
 
 }  // namespace bike_computer
@@ -26,6 +26,7 @@
 
 #include "Callback.h"
 #include "constants.hpp"
+#include "drivetrain.hpp"
 #include "mbed.h"
 
 namespace bike_computer {
@@ -34,21 +35,34 @@ class Speedometer {
    public:
     explicit Speedometer(Timer& timer);  // NOLINT(runtime/references)
 
-    // method used for setting the current pedal rotation time
+    // method used for setting the current pedal rotation time, a zero rotation
+    // time means that the crank stopped turning (zero speed)
     void setCurrentRotationTime(const std::chrono::milliseconds& currentRotationTime);
 
     // method used for setting/getting the current gear
     void setGearSize(uint8_t gearSize);
 
+    // methods used for changing the drivetrain (the distance table is computed
+    // here, not on gear or pedal events), the first chainring of the profile is
+    // used
+    bool setDrivetrainProfile(const DrivetrainProfile& profile);
+    const Drivetrain& getDrivetrain() const;
+
     // method called for getting the current speed (expressed in km / h)
     float getCurrentSpeed() const;
 
-    // method called for getting the current traveled distance (expressed in km)
-    float getDistance();
+    // method called for getting the current traveled distance (expressed in km),
+    // extrapolated at the current speed without modifying the speedometer, it may
+    // be called from any thread
+    float getDistance() const;
 
     // method called for resetting the traveled distance
     void reset();
 
+    // method called for restoring the traveled distance (expressed in km) after a
+    // restart, the distance is then integrated from the current time
+    void restoreDistance(float distance);
+
     // methods used for tests only
 #if defined(MBED_TEST_MODE)
     uint8_t getGearSize() const;
@@ -56,38 +70,51 @@ class Speedometer {
     float getTraySize() const;
     std::chrono::milliseconds getCurrentPedalRotationTime() const;
     void setOnResetCallback(mbed::Callback<void()> callback);
+    // replace the timer by a simulated time (the distance is integrated from the
+    // current simulated time)
+    void setTimeSource(mbed::Callback<std::chrono::microseconds()> timeSource);
+    // the board has no chainring input
+    void setChainring(uint8_t chainring);
 
    private:
     Callback<void()> _callback;
+    Callback<std::chrono::microseconds()> _timeSource;
 #endif  // defined(MBED_TEST_MODE)
 
    private:
     // private methods
-    void computeSpeed();
-    void computeDistance();
+    std::chrono::microseconds getCurrentTime() const;
+    float computeSpeed() const;
+    static float computeDistance(float speed,
+                                 const std::chrono::microseconds& elapsedTime);
+    void publish(float currentSpeed);
 
     // definition of task period time
     static constexpr std::chrono::milliseconds kTaskPeriod = 400ms;
     // definition of task execution time
     static constexpr std::chrono::microseconds kTaskRunTime = 200000us;
 
-    // constants related to speed computation
+    // wheel, chainrings and cassette (the default profile corresponds to a
+    // 2.1 m wheel and a 50 teeth chainring)
+    Drivetrain _drivetrain;
+    uint8_t _chainring = 0;
 
-    //
-    // cppcheck-suppress unusedStructMember
-    static constexpr float kWheelCircumference = 2.1f;
-    // cppcheck-suppress unusedStructMember
-    static constexpr uint8_t kTraySize           = 50;
-    std::chrono::microseconds _lastTime          = std::chrono::microseconds::zero();
     std::chrono::milliseconds _pedalRotationTime = kInitialPedalRotationTime;
 
     // data members
     Timer& _timer;
     LowPowerTicker _ticker;
-    float _currentSpeed = 0.0f;
-    Mutex _totalDistanceMutex;
-    float _totalDistance = 0.0f;
-    uint8_t _gearSize    = 19;  // corresponds with min gear
+    // only one writer at a time (events and reset may come from different threads)
+    Mutex _writerMutex;
+    // published state, read with the sequence number (odd while being written)
+    volatile uint32_t _sequence         = 0;
+    float _currentSpeed                 = 0.0f;
+    // accumulated in double: in float, each increment of a long ride would be
+    // rounded to the resolution of the total (about 8 mm above 64 km)
+    double _totalDistance               = 0.0;
+    std::chrono::microseconds _lastTime = std::chrono::microseconds::zero();
+
+    uint8_t _gearSize = 19;  // corresponds with min gear
 
     Thread _thread;
 };
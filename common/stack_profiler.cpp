@@ -0,0 +1,83 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file stack_profiler.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Thread stack profiler implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/stack_profiler.hpp"
+
+#include "mbed_stats.h"
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "StackProfiler"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+StackProfiler::StackProfiler(uint32_t marginPercent) : _marginPercent(marginPercent) {}
+
+uint32_t StackProfiler::getRecommendedSize(uint32_t peakUsage) const {
+    uint32_t size = peakUsage + (peakUsage * _marginPercent + 99) / 100;
+    // stacks must be 8 bytes aligned
+    size = (size + 7) & ~static_cast<uint32_t>(7);
+    return size < kMinStackSize ? kMinStackSize : size;
+}
+
+void StackProfiler::printReport() {
+#if defined(MBED_STACK_STATS_ENABLED)
+    // mbed_stats_stack_get_each() allocates its thread list on the heap, the
+    // snapshot is taken in preallocated storage instead
+    osKernelLock();
+    const uint32_t nbrOfThreads = osThreadEnumerate(_threadIds, kMaxThreads);
+    for (uint32_t index = 0; index < nbrOfThreads; index++) {
+        const uint32_t stackSize        = osThreadGetStackSize(_threadIds[index]);
+        _stackStats[index].name         = osThreadGetName(_threadIds[index]);
+        _stackStats[index].reservedSize = stackSize;
+        _stackStats[index].maxSize = stackSize - osThreadGetStackSpace(_threadIds[index]);
+    }
+    osKernelUnlock();
+
+    uint32_t totalReserved    = 0;
+    uint32_t totalRecommended = 0;
+    tr_info("Stack report (margin %" PRIu32 "%%):", _marginPercent);
+    for (uint32_t index = 0; index < nbrOfThreads; index++) {
+        const ThreadStackStats& stackStats = _stackStats[index];
+        const uint32_t recommended         = getRecommendedSize(stackStats.maxSize);
+        tr_info("  %s: peak %" PRIu32 " / %" PRIu32 " bytes, recommended %" PRIu32
+                " bytes",
+                stackStats.name != nullptr ? stackStats.name : "unknown",
+                stackStats.maxSize,
+                stackStats.reservedSize,
+                recommended);
+        totalReserved += stackStats.reservedSize;
+        totalRecommended += recommended;
+    }
+    if (totalRecommended < totalReserved) {
+        tr_info("  %" PRIu32 " bytes of SRAM could be saved",
+                totalReserved - totalRecommended);
+    }
+#else
+    tr_warn("Stack statistics are disabled (platform.stack-stats-enabled)");
+#endif  // defined(MBED_STACK_STATS_ENABLED)
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,67 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file stack_profiler.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Thread stack high-water marks and recommended stack sizes. Stacks
+ *        are painted at thread creation by RTX when stack statistics are
+ *        enabled ("platform.stack-stats-enabled")
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+class StackProfiler {
+   public:
+    // safety margin, in percent of the measured peak
+    explicit StackProfiler(uint32_t marginPercent);
+
+    // make the class non copyable
+    StackProfiler(StackProfiler&)            = delete;
+    StackProfiler& operator=(StackProfiler&) = delete;
+
+    // print, for each thread, the reserved size, the peak usage measured since
+    // thread creation and the recommended stack size (does not allocate, may be
+    // called in heap steady state)
+    void printReport();
+
+    // recommended size for a given peak usage (margin added, 8 bytes aligned)
+    uint32_t getRecommendedSize(uint32_t peakUsage) const;
+
+   private:
+    // never recommend less than this
+    static constexpr uint32_t kMinStackSize = 512;
+    static constexpr uint8_t kMaxThreads    = 12;
+
+    struct ThreadStackStats {
+        const char* name;
+        uint32_t reservedSize;
+        uint32_t maxSize;
+    };
+
+    uint32_t _marginPercent;
+    // snapshot of the thread stacks, taken with the kernel locked
+    osThreadId_t _threadIds[kMaxThreads]      = {};
+    ThreadStackStats _stackStats[kMaxThreads] = {};
+};
+
+}  // namespace bike_computer
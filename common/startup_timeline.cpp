@@ -0,0 +1,151 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file startup_timeline.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Startup timeline implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include "common/startup_timeline.hpp"
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "StartupTimeline"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+StartupTimeline& StartupTimeline::getInstance() {
+    static StartupTimeline startupTimeline;
+    return startupTimeline;
+}
+
+StartupTimeline::StartupTimeline()
+    : _thread(osPriorityLow,
+              MBED_CONF_APP_INIT_THREAD_STACK_SIZE,
+              nullptr,
+              "StartupThread") {
+    _timer.start();
+}
+
+std::chrono::microseconds StartupTimeline::now() const { return _timer.elapsed_time(); }
+
+void StartupTimeline::record(const char* name,
+                             const std::chrono::microseconds& startTime,
+                             const std::chrono::microseconds& endTime) {
+    ScopedLock<Mutex> lock(_mutex);
+    if (_nbrOfEntries == kMaxEntries) {
+        return;
+    }
+    _entries[_nbrOfEntries].name      = name;
+    _entries[_nbrOfEntries].startTime = static_cast<uint32_t>(startTime.count());
+    _entries[_nbrOfEntries].endTime   = static_cast<uint32_t>(endTime.count());
+    _nbrOfEntries++;
+}
+
+void StartupTimeline::markFirstFrame() {
+    if (_firstFrameShown) {
+        return;
+    }
+    const std::chrono::microseconds firstFrameTime = now();
+    {
+        ScopedLock<Mutex> lock(_mutex);
+        if (_firstFrameShown) {
+            return;
+        }
+        _firstFrameShown = true;
+    }
+    record("FirstFrame", firstFrameTime, firstFrameTime);
+    tr_info("First frame shown %" PRIu32 " ms after boot",
+            static_cast<uint32_t>(firstFrameTime.count() / 1000));
+    _eventFlags.set(kFirstFrameFlag);
+}
+
+bool StartupTimeline::isFirstFrameShown() const { return _firstFrameShown; }
+
+bool StartupTimeline::defer(const char* name, Callback<void()> jobCallback) {
+    {
+        ScopedLock<Mutex> lock(_mutex);
+        if (_nbrOfDeferredJobs == kMaxDeferredJobs) {
+            tr_error("Cannot defer %s", name);
+            return false;
+        }
+        const uint8_t index = (_firstDeferredJob + _nbrOfDeferredJobs) % kMaxDeferredJobs;
+
+        _deferredJobs[index].name     = name;
+        _deferredJobs[index].callback = jobCallback;
+        _nbrOfDeferredJobs++;
+
+        if (!_threadStarted) {
+            _thread.start(callback(this, &StartupTimeline::runDeferredJobs));
+            _threadStarted = true;
+        }
+    }
+    _eventFlags.set(kDeferredJobFlag);
+    return true;
+}
+
+void StartupTimeline::printTimeline() {
+    ScopedLock<Mutex> lock(_mutex);
+    tr_info("Startup timeline (%d entries)", _nbrOfEntries);
+    for (uint8_t index = 0; index < _nbrOfEntries; index++) {
+        tr_info("  %-20s %8" PRIu32 " us -> %8" PRIu32 " us (%" PRIu32 " us)",
+                _entries[index].name,
+                _entries[index].startTime,
+                _entries[index].endTime,
+                _entries[index].endTime - _entries[index].startTime);
+    }
+}
+
+void StartupTimeline::runDeferredJobs() {
+    // the flag is never cleared
+    _eventFlags.wait_any(kFirstFrameFlag, osWaitForever, false);
+
+    bool timelinePrinted = false;
+    while (true) {
+        DeferredJob deferredJob = {};
+        bool hasJob             = false;
+        {
+            ScopedLock<Mutex> lock(_mutex);
+            if (_nbrOfDeferredJobs > 0) {
+                deferredJob       = _deferredJobs[_firstDeferredJob];
+                _firstDeferredJob = (_firstDeferredJob + 1) % kMaxDeferredJobs;
+                _nbrOfDeferredJobs--;
+                hasJob = true;
+            }
+        }
+
+        if (hasJob) {
+            const std::chrono::microseconds startTime = now();
+            deferredJob.callback();
+            record(deferredJob.name, startTime, now());
+        } else {
+            // the startup is complete once the jobs deferred during the boot are done
+            if (!timelinePrinted) {
+                printTimeline();
+                timelinePrinted = true;
+            }
+            _eventFlags.wait_any(kDeferredJobFlag);
+        }
+    }
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,104 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file startup_timeline.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Startup timeline and jobs deferred until the first frame is shown
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// times are measured from the first use of the timeline, early in main(). The
+// init jobs record their start and end, the first frame shown on the display is
+// a milestone. Jobs that are not needed for the first frame (statistics, update
+// client) are deferred: they run one after the other on a low priority thread once
+// the first frame is shown, the timeline is printed when they are done.
+class StartupTimeline {
+   public:
+    static constexpr uint8_t kMaxEntries      = 16;
+    static constexpr uint8_t kMaxDeferredJobs = 8;
+
+    static StartupTimeline& getInstance();
+
+    // make the class non copyable
+    StartupTimeline(StartupTimeline&)            = delete;
+    StartupTimeline& operator=(StartupTimeline&) = delete;
+
+    std::chrono::microseconds now() const;
+
+    // may be called from any thread, entries above kMaxEntries are dropped
+    void record(const char* name,
+                const std::chrono::microseconds& startTime,
+                const std::chrono::microseconds& endTime);
+
+    // only the first call is recorded, may be called from any thread
+    void markFirstFrame();
+    bool isFirstFrameShown() const;
+
+    // run jobCallback once the first frame is shown (immediately if it is already
+    // shown), in the order of the calls. The object bound to jobCallback must outlive
+    // the job. Returns false if too many jobs are pending.
+    bool defer(const char* name, Callback<void()> jobCallback);
+
+    void printTimeline();
+
+   private:
+    StartupTimeline();
+
+    void runDeferredJobs();
+
+    static constexpr uint32_t kFirstFrameFlag  = (1UL << 0);
+    static constexpr uint32_t kDeferredJobFlag = (1UL << 1);
+
+    struct Entry {
+        const char* name;
+        // expressed in us
+        uint32_t startTime;
+        uint32_t endTime;
+    };
+
+    struct DeferredJob {
+        const char* name;
+        Callback<void()> callback;
+    };
+
+    Timer _timer;
+    Mutex _mutex;
+    EventFlags _eventFlags;
+    Thread _thread;
+    bool _threadStarted = false;
+
+    Entry _entries[kMaxEntries]    = {};
+    uint8_t _nbrOfEntries          = 0;
+    volatile bool _firstFrameShown = false;
+
+    // pending deferred jobs, in a circular buffer
+    DeferredJob _deferredJobs[kMaxDeferredJobs] = {};
+    uint8_t _firstDeferredJob                   = 0;
+    uint8_t _nbrOfDeferredJobs                  = 0;
+};
+
+}  // namespace bike_computer
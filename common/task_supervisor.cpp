@@ -0,0 +1,228 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file task_supervisor.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Task supervisor implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/task_supervisor.hpp"
+
+#include "common/retained_ride_state.hpp"
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "TaskSupervisor"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+SimulatedWatchdog::SimulatedWatchdog(Timer& timer) : _timer(timer) {}
+
+void SimulatedWatchdog::start(const std::chrono::milliseconds& timeout) {
+    _timeout  = timeout;
+    _kickTime = _timer.elapsed_time();
+    _started  = true;
+}
+
+void SimulatedWatchdog::kick() {
+    _kickTime = _timer.elapsed_time();
+    _nbrOfKicks++;
+}
+
+bool SimulatedWatchdog::isExpired() const {
+    return _started && _timer.elapsed_time() - _kickTime > _timeout;
+}
+
+uint32_t SimulatedWatchdog::getNbrOfKicks() const { return _nbrOfKicks; }
+
+TaskSupervisor::TaskSupervisor(Timer& timer,
+                               const std::chrono::milliseconds& watchdogTimeout)
+    : _timer(timer), _simulatedWatchdog(nullptr), _watchdogTimeout(watchdogTimeout) {}
+
+TaskSupervisor::TaskSupervisor(Timer& timer,
+                               SimulatedWatchdog& watchdog,
+                               const std::chrono::milliseconds& watchdogTimeout)
+    : _timer(timer), _simulatedWatchdog(&watchdog), _watchdogTimeout(watchdogTimeout) {}
+
+TaskSupervisor::HeartbeatId TaskSupervisor::registerTask(
+    const char* name,
+    const std::chrono::milliseconds& period,
+    const std::chrono::milliseconds& tolerance) {
+    if (_nbrOfTasks == kMaxTasks) {
+        tr_error("Too many tasks, %s is not supervised", name);
+        return kInvalidHeartbeatId;
+    }
+    Heartbeat& heartbeat   = _heartbeats[_nbrOfTasks];
+    heartbeat.name         = name;
+    heartbeat.budget       = period + tolerance;
+    heartbeat.lastBeatTime = _timer.elapsed_time().count();
+    heartbeat.nbrOfBeats   = 0;
+    heartbeat.nbrOfMisses  = 0;
+    heartbeat.maxInterval  = std::chrono::microseconds::zero();
+    heartbeat.missed       = false;
+    return _nbrOfTasks++;
+}
+
+bool TaskSupervisor::start() {
+    if (_simulatedWatchdog == nullptr) {
+        reportWatchdogReset();
+    }
+
+    const uint64_t now = _timer.elapsed_time().count();
+    for (uint8_t index = 0; index < _nbrOfTasks; index++) {
+        core_util_atomic_store_u64(&_heartbeats[index].lastBeatTime, now);
+    }
+
+    if (_simulatedWatchdog != nullptr) {
+        _simulatedWatchdog->start(_watchdogTimeout);
+        return true;
+    }
+#if DEVICE_WATCHDOG
+    return Watchdog::get_instance().start(_watchdogTimeout.count());
+#else
+    tr_error("No hardware watchdog on this target");
+    return false;
+#endif  // DEVICE_WATCHDOG
+}
+
+void TaskSupervisor::heartbeat(HeartbeatId heartbeatId) {
+    if (heartbeatId >= _nbrOfTasks) {
+        return;
+    }
+    Heartbeat& heartbeat = _heartbeats[heartbeatId];
+    const uint64_t now   = _timer.elapsed_time().count();
+    const std::chrono::microseconds interval(
+        now - core_util_atomic_exchange_u64(&heartbeat.lastBeatTime, now));
+    // the first interval is measured from the start of the supervision
+    if (interval > heartbeat.maxInterval) {
+        heartbeat.maxInterval = interval;
+    }
+    core_util_atomic_incr_u32(&heartbeat.nbrOfBeats, 1);
+}
+
+void TaskSupervisor::check() {
+    // the stale task that is the most overdue is the one reported
+    const std::chrono::microseconds now  = _timer.elapsed_time();
+    HeartbeatId missedIndex              = kInvalidHeartbeatId;
+    std::chrono::microseconds maxOverdue = std::chrono::microseconds::zero();
+    for (uint8_t index = 0; index < _nbrOfTasks; index++) {
+        Heartbeat& heartbeat = _heartbeats[index];
+        const std::chrono::microseconds age =
+            now - std::chrono::microseconds(
+                      core_util_atomic_load_u64(&heartbeat.lastBeatTime));
+        if (age <= heartbeat.budget) {
+            heartbeat.missed = false;
+            continue;
+        }
+        if (!heartbeat.missed) {
+            // logged once per miss, the watchdog resets the system if the task
+            // does not recover
+            heartbeat.missed = true;
+            heartbeat.nbrOfMisses++;
+            tr_error("%s missed its heartbeat: none for %" PRIu32 " ms (budget %" PRIu32
+                     " ms)",
+                     heartbeat.name,
+                     static_cast<uint32_t>(age.count() / 1000),
+                     static_cast<uint32_t>(heartbeat.budget.count() / 1000));
+        }
+        if (missedIndex == kInvalidHeartbeatId || age - heartbeat.budget > maxOverdue) {
+            missedIndex = index;
+            maxOverdue  = age - heartbeat.budget;
+        }
+    }
+
+    if (missedIndex == kInvalidHeartbeatId) {
+        if (_missedTask != nullptr) {
+            // all tasks recovered, the record must not blame them at the next reset
+            _missedTask = nullptr;
+            if (_simulatedWatchdog == nullptr) {
+                RetainedRideState::getInstance().clearMissedTask();
+            }
+        }
+        kickWatchdog();
+        return;
+    }
+    if (_missedTask != _heartbeats[missedIndex].name) {
+        _missedTask = _heartbeats[missedIndex].name;
+        if (_simulatedWatchdog == nullptr) {
+            // kept across the watchdog reset, reported at the next start
+            RetainedRideState::getInstance().saveMissedTask(missedIndex);
+        }
+    }
+}
+
+const char* TaskSupervisor::getMissedTask() const { return _missedTask; }
+
+bool TaskSupervisor::getStats(HeartbeatId heartbeatId, HeartbeatStats& stats) const {
+    if (heartbeatId >= _nbrOfTasks) {
+        return false;
+    }
+    const Heartbeat& heartbeat = _heartbeats[heartbeatId];
+    stats.nbrOfBeats           = heartbeat.nbrOfBeats;
+    stats.nbrOfMisses          = heartbeat.nbrOfMisses;
+    stats.maxInterval          = heartbeat.maxInterval;
+    stats.budget               = heartbeat.budget;
+    return true;
+}
+
+void TaskSupervisor::printStats() const {
+    for (HeartbeatId heartbeatId = 0; heartbeatId < _nbrOfTasks; heartbeatId++) {
+        HeartbeatStats stats;
+        getStats(heartbeatId, stats);
+        tr_info("%s: %" PRIu32 " heartbeats, %" PRIu32 " missed, max interval %" PRIu32
+                " ms (budget %" PRIu32 " ms)",
+                _heartbeats[heartbeatId].name,
+                stats.nbrOfBeats,
+                stats.nbrOfMisses,
+                static_cast<uint32_t>(stats.maxInterval.count() / 1000),
+                static_cast<uint32_t>(stats.budget.count() / 1000));
+    }
+}
+
+void TaskSupervisor::reportWatchdogReset() const {
+    // the saved task id is cleared in any case, it belongs to the previous run
+    uint8_t taskId       = kInvalidHeartbeatId;
+    const bool hasMissed = RetainedRideState::getInstance().takeMissedTask(taskId);
+#if DEVICE_RESET_REASON
+    if (ResetReason::get() != RESET_REASON_WATCHDOG) {
+        return;
+    }
+    if (hasMissed && taskId < _nbrOfTasks) {
+        tr_warn("The system was reset by the watchdog: %s missed its heartbeat",
+                _heartbeats[taskId].name);
+    } else {
+        tr_warn("The system was reset by the watchdog");
+    }
+#else
+    (void)hasMissed;
+#endif  // DEVICE_RESET_REASON
+}
+
+void TaskSupervisor::kickWatchdog() {
+    if (_simulatedWatchdog != nullptr) {
+        _simulatedWatchdog->kick();
+        return;
+    }
+#if DEVICE_WATCHDOG
+    Watchdog::get_instance().kick();
+#endif  // DEVICE_WATCHDOG
+}
+
+}  // namespace bike_computer
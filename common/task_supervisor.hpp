@@ -0,0 +1,137 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file task_supervisor.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Task heartbeats and watchdog supervision
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+// replaces the hardware watchdog in test mode: expiring does not reset the
+// system, it is only reported
+class SimulatedWatchdog {
+   public:
+    explicit SimulatedWatchdog(Timer& timer);  // NOLINT(runtime/references)
+
+    // make the class non copyable
+    SimulatedWatchdog(SimulatedWatchdog&)            = delete;
+    SimulatedWatchdog& operator=(SimulatedWatchdog&) = delete;
+
+    void start(const std::chrono::milliseconds& timeout);
+    void kick();
+
+    // true if the hardware watchdog would have reset the system
+    bool isExpired() const;
+    uint32_t getNbrOfKicks() const;
+
+   private:
+    Timer& _timer;
+    std::chrono::microseconds _timeout  = std::chrono::microseconds::zero();
+    std::chrono::microseconds _kickTime = std::chrono::microseconds::zero();
+    bool _started                       = false;
+    uint32_t _nbrOfKicks                = 0;
+};
+
+struct HeartbeatStats {
+    uint32_t nbrOfBeats;
+    uint32_t nbrOfMisses;
+    // largest time between two heartbeats, to be compared with the budget
+    std::chrono::microseconds maxInterval;
+    std::chrono::microseconds budget;
+};
+
+// each supervised task registers a heartbeat with its expected period and a
+// tolerance. The heartbeats are checked periodically (kCheckPeriod) and the
+// watchdog is kicked only when all of them are fresh: a task stuck or not
+// scheduled anymore leads to a watchdog reset. The most overdue task at the
+// last check is kept in retained RAM and reported at the next start after the
+// reset, the record is cleared when all tasks recover.
+class TaskSupervisor {
+   public:
+    using HeartbeatId = uint8_t;
+
+    static constexpr uint8_t kMaxTasks                      = 8;
+    static constexpr HeartbeatId kInvalidHeartbeatId        = 0xFF;
+    static constexpr std::chrono::milliseconds kCheckPeriod = 500ms;
+
+    // kicks the hardware watchdog
+    TaskSupervisor(Timer& timer,  // NOLINT(runtime/references)
+                   const std::chrono::milliseconds& watchdogTimeout);
+    // kicks the simulated watchdog
+    TaskSupervisor(Timer& timer,                  // NOLINT(runtime/references)
+                   SimulatedWatchdog& watchdog,   // NOLINT(runtime/references)
+                   const std::chrono::milliseconds& watchdogTimeout);
+
+    // make the class non copyable
+    TaskSupervisor(TaskSupervisor&)            = delete;
+    TaskSupervisor& operator=(TaskSupervisor&) = delete;
+
+    // the heartbeat is missed when no heartbeat is received during
+    // period + tolerance
+    HeartbeatId registerTask(const char* name,
+                             const std::chrono::milliseconds& period,
+                             const std::chrono::milliseconds& tolerance);
+
+    // report a previous watchdog reset with the task that missed its heartbeat
+    // (tasks must be registered in the same order) and arm the watchdog, all
+    // heartbeats are considered as fresh at this time
+    bool start();
+
+    // called by the task at each run, from any thread
+    void heartbeat(HeartbeatId heartbeatId);
+
+    // check the heartbeats and kick the watchdog if they are all fresh, to be
+    // called every kCheckPeriod from a thread that runs no supervised task
+    void check();
+
+    // name of the most overdue task at the last check, nullptr if all fresh
+    const char* getMissedTask() const;
+    bool getStats(HeartbeatId heartbeatId, HeartbeatStats& stats) const;
+    void printStats() const;
+
+   private:
+    void reportWatchdogReset() const;
+    void kickWatchdog();
+
+    struct Heartbeat {
+        const char* name;
+        std::chrono::microseconds budget;
+        // expressed in us, written from the thread of the task
+        volatile uint64_t lastBeatTime;
+        uint32_t nbrOfBeats;
+        uint32_t nbrOfMisses;
+        std::chrono::microseconds maxInterval;
+        bool missed;
+    };
+
+    Timer& _timer;
+    // nullptr when the hardware watchdog is used
+    SimulatedWatchdog* _simulatedWatchdog;
+    const std::chrono::milliseconds _watchdogTimeout;
+    Heartbeat _heartbeats[kMaxTasks] = {};
+    uint8_t _nbrOfTasks              = 0;
+    const char* _missedTask          = nullptr;
+};
+
+}  // namespace bike_computer
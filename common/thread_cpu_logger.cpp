@@ -0,0 +1,207 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file thread_cpu_logger.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Per-thread CPU accounting implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/thread_cpu_logger.hpp"
+
+#include <cstring>
+
+#include "cmsis.h"
+#include "mbed_trace.h"
+#include "rtx_os.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "ThreadCPULogger"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+// RTX calls these hooks each time a new thread is selected for running and when a
+// thread is destroyed, the thread events are disabled in the default RTX
+// configuration and are enabled in mbed_app.json (OS_EVR_THREAD), the other thread
+// events keep their weak RTX definitions
+extern "C" void EvrRtxThreadSwitched(osThreadId_t thread_id) {
+    bike_computer::ThreadCPULogger::getInstance().onThreadSwitch(thread_id);
+}
+
+extern "C" void EvrRtxThreadDestroyed(osThreadId_t thread_id) {
+    bike_computer::ThreadCPULogger::getInstance().onThreadDestroyed(thread_id);
+}
+
+namespace bike_computer {
+
+ThreadCPULogger& ThreadCPULogger::getInstance() {
+    static ThreadCPULogger threadCPULogger;
+    return threadCPULogger;
+}
+
+void ThreadCPULogger::start() {
+    // enable the DWT cycle counter
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORE_CM7_H_GENERIC)
+    // unlock the DWT registers (required on Cortex-M7)
+    DWT->LAR = 0xC5ACCE55;
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    core_util_critical_section_enter();
+    _currentThreadId = ThisThread::get_id();
+    _lastCycleCount  = DWT->CYCCNT;
+    _started         = true;
+    core_util_critical_section_exit();
+}
+
+ThreadCPULogger::ThreadStats* ThreadCPULogger::findOrAddThread(osThreadId_t threadId) {
+    ThreadStats* freeSlot = nullptr;
+    for (uint8_t index = 0; index < kMaxThreads; index++) {
+        if (_stats[index].threadId == threadId) {
+            return &_stats[index];
+        }
+        if (freeSlot == nullptr && _stats[index].threadId == nullptr) {
+            freeSlot = &_stats[index];
+        }
+    }
+    if (freeSlot == nullptr) {
+        // the cycles of the thread are reported with the other threads
+        return &_otherStats;
+    }
+    // the name is copied while the thread exists (the thread may be destroyed
+    // before the statistics are printed)
+    const char* name = static_cast<const osRtxThread_t*>(threadId)->name;
+    *freeSlot        = {};
+    strncpy(freeSlot->name, name != nullptr ? name : "unknown", kMaxThreadNameLength - 1);
+    freeSlot->threadId = threadId;
+    return freeSlot;
+}
+
+void ThreadCPULogger::onThreadSwitch(osThreadId_t nextThreadId) {
+    if (!_started || nextThreadId == _currentThreadId) {
+        return;
+    }
+
+    // account the cycles elapsed since the last switch to the previous thread (to
+    // the other threads if it has been destroyed in the meantime)
+    const uint32_t cycleCount = DWT->CYCCNT;
+    if (_currentThreadId == nullptr) {
+        _otherStats.cycles += cycleCount - _lastCycleCount;
+    } else {
+        ThreadStats* previous = findOrAddThread(_currentThreadId);
+        previous->cycles += cycleCount - _lastCycleCount;
+        // a thread that is still ready when switched out has been preempted
+        const auto* thread = static_cast<const osRtxThread_t*>(_currentThreadId);
+        if ((thread->state & osRtxThreadStateMask) == osRtxThreadReady) {
+            previous->preemptions++;
+        }
+    }
+
+    if (nextThreadId != nullptr) {
+        findOrAddThread(nextThreadId)->switches++;
+    }
+
+    _currentThreadId = nextThreadId;
+    _lastCycleCount  = cycleCount;
+}
+
+void ThreadCPULogger::onThreadDestroyed(osThreadId_t threadId) {
+    if (!_started || threadId == nullptr) {
+        return;
+    }
+
+    // a thread terminating itself is still the current thread
+    const uint32_t cycleCount = DWT->CYCCNT;
+    if (threadId == _currentThreadId) {
+        findOrAddThread(threadId)->cycles += cycleCount - _lastCycleCount;
+        _currentThreadId = nullptr;
+        _lastCycleCount  = cycleCount;
+    }
+
+    // the counters since the last print are reported with the other threads and
+    // the slot is released (the thread id may be reused by a new thread)
+    for (uint8_t index = 0; index < kMaxThreads; index++) {
+        ThreadStats& stats = _stats[index];
+        if (stats.threadId == threadId) {
+            _otherStats.cycles += stats.cycles;
+            _otherStats.switches += stats.switches;
+            _otherStats.preemptions += stats.preemptions;
+            stats = {};
+            return;
+        }
+    }
+}
+
+void ThreadCPULogger::printStats() {
+    // copy and clear the statistics updated in handler mode
+    ThreadStats stats[kMaxThreads];
+    core_util_critical_section_enter();
+    // also account the running thread up to now
+    const uint32_t cycleCount = DWT->CYCCNT;
+    if (_started) {
+        if (_currentThreadId == nullptr) {
+            _otherStats.cycles += cycleCount - _lastCycleCount;
+        } else {
+            findOrAddThread(_currentThreadId)->cycles += cycleCount - _lastCycleCount;
+        }
+        _lastCycleCount = cycleCount;
+    }
+    for (uint8_t index = 0; index < kMaxThreads; index++) {
+        stats[index]              = _stats[index];
+        _stats[index].cycles      = 0;
+        _stats[index].switches    = 0;
+        _stats[index].preemptions = 0;
+    }
+    const ThreadStats otherStats = _otherStats;
+    _otherStats                  = {};
+    core_util_critical_section_exit();
+
+    uint64_t totalCycles = otherStats.cycles;
+    for (uint8_t index = 0; index < kMaxThreads; index++) {
+        totalCycles += stats[index].cycles;
+    }
+    if (totalCycles == 0) {
+        tr_warn("No thread switch recorded (is the RTX thread switch event enabled?)");
+        return;
+    }
+
+    for (uint8_t index = 0; index < kMaxThreads; index++) {
+        if (stats[index].threadId == nullptr) {
+            continue;
+        }
+        const float usage =
+            (100.0f * stats[index].cycles) / static_cast<float>(totalCycles);
+        tr_info("%s: %f %% cpu, %" PRIu32 " switches, %" PRIu32 " preemptions",
+                stats[index].name,
+                usage,
+                stats[index].switches,
+                stats[index].preemptions);
+    }
+    if (otherStats.cycles != 0 || otherStats.switches != 0) {
+        const float usage =
+            (100.0f * otherStats.cycles) / static_cast<float>(totalCycles);
+        tr_info("other (destroyed or not tracked threads): %f %% cpu, %" PRIu32
+                " switches, %" PRIu32 " preemptions",
+                usage,
+                otherStats.switches,
+                otherStats.preemptions);
+    }
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,82 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file thread_cpu_logger.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Per-thread CPU accounting, driven by the RTX thread switch hook and
+ *        the DWT cycle counter
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+class ThreadCPULogger {
+   public:
+    static ThreadCPULogger& getInstance();
+
+    // make the class non copyable
+    ThreadCPULogger(ThreadCPULogger&)            = delete;
+    ThreadCPULogger& operator=(ThreadCPULogger&) = delete;
+
+    // enable the cycle counter and start accounting
+    void start();
+
+    // print utilisation, context switches and preemptions per thread since the
+    // previous call (to be called once per major cycle)
+    void printStats();
+
+    // called by the kernel on each thread switch (handler mode)
+    void onThreadSwitch(osThreadId_t nextThreadId);
+
+    // called by the kernel when a thread is destroyed, its slot is released
+    void onThreadDestroyed(osThreadId_t threadId);
+
+   private:
+    ThreadCPULogger() = default;
+
+    static constexpr uint8_t kMaxThreads = MBED_CONF_APP_THREAD_CPU_LOGGER_MAX_THREADS;
+
+    // longer names are truncated
+    static constexpr uint8_t kMaxThreadNameLength = 16;
+
+    // counters since the previous call to printStats()
+    struct ThreadStats {
+        osThreadId_t threadId;
+        char name[kMaxThreadNameLength];
+        uint64_t cycles;
+        uint32_t switches;
+        uint32_t preemptions;
+    };
+
+    ThreadStats* findOrAddThread(osThreadId_t threadId);
+
+    // written in handler mode and in critical sections only, a slot is free when
+    // its thread id is null
+    ThreadStats _stats[kMaxThreads] = {};
+    // destroyed threads and threads without slot
+    ThreadStats _otherStats         = {};
+    osThreadId_t _currentThreadId   = nullptr;
+    uint32_t _lastCycleCount        = 0;
+    volatile bool _started          = false;
+};
+
+}  // namespace bike_computer
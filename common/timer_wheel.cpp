@@ -0,0 +1,328 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file timer_wheel.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Hierarchical timer wheel implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/timer_wheel.hpp"
+
+#include <cstring>
+
+#include "mbed_trace.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "TimerWheel"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace bike_computer {
+
+TimerWheel::TimerWheel(EventQueue& eventQueue,
+                       const std::chrono::milliseconds& tickPeriod)
+    : _eventQueue(eventQueue),
+      _tickPeriod(tickPeriod),
+      _tickEvent(&eventQueue, callback(this, &TimerWheel::onTick)) {
+    memset(_slots, kInvalidTimerId, sizeof(_slots));
+    memset(_slotTails, kInvalidTimerId, sizeof(_slotTails));
+}
+
+bool TimerWheel::start() {
+    _timer.start();
+    _tickEvent.delay(std::chrono::milliseconds::zero());
+    _tickEvent.period(_tickPeriod);
+    return _tickEvent.post() != 0;
+}
+
+void TimerWheel::stop() {
+    _tickEvent.cancel();
+    _timer.stop();
+}
+
+TimerWheel::TimerId TimerWheel::addTimer(const char* name,
+                                         Callback<void()> callback,
+                                         const std::chrono::milliseconds& period,
+                                         const std::chrono::milliseconds& offset,
+                                         TimerAlignment alignment) {
+    TimerId timerId = 0;
+    while (timerId < kMaxTimers && _timers[timerId].used) {
+        timerId++;
+    }
+    if (timerId == kMaxTimers) {
+        tr_error("No timer left for %s", name);
+        return kInvalidTimerId;
+    }
+
+    TimerEntry& timer      = _timers[timerId];
+    timer.callback         = callback;
+    timer.name             = name;
+    timer.period           = toPeriodTicks(period);
+    timer.used             = true;
+    timer.stretch          = 1;
+    timer.suspended        = false;
+    timer.nbrOfRuns        = 0;
+    timer.nbrOfSkippedRuns = 0;
+    timer.lastLateness     = std::chrono::microseconds::zero();
+    timer.maxLateness      = std::chrono::microseconds::zero();
+    timer.totalLateness    = 0;
+    timer.maxRunTime       = std::chrono::microseconds::zero();
+
+    // the first tick that is not processed yet
+    const uint32_t nextTick    = _currentTick + 1;
+    const uint32_t offsetTicks = toTicks(offset);
+    if (alignment == TimerAlignment::Absolute && timer.period > 0) {
+        if (nextTick > offsetTicks) {
+            const uint32_t phase = (nextTick - offsetTicks) % timer.period;
+            timer.expiry         = nextTick + (phase == 0 ? 0 : timer.period - phase);
+        } else {
+            timer.expiry = offsetTicks;
+        }
+    } else {
+        timer.expiry = nextTick + offsetTicks;
+    }
+    insert(timerId);
+    return timerId;
+}
+
+bool TimerWheel::removeTimer(TimerId timerId) {
+    if (timerId >= kMaxTimers || !_timers[timerId].used) {
+        return false;
+    }
+    if (timerId == _runningTimerId) {
+        // already unlinked, it must not be inserted again
+        _runningTimerRemoved = true;
+    } else {
+        unlink(timerId);
+    }
+    _timers[timerId].used = false;
+    return true;
+}
+
+bool TimerWheel::setPeriod(TimerId timerId, const std::chrono::milliseconds& period) {
+    const uint32_t periodTicks = toPeriodTicks(period);
+    if (timerId >= kMaxTimers || !_timers[timerId].used || periodTicks == 0 ||
+        _timers[timerId].period == 0) {
+        return false;
+    }
+    _timers[timerId].period = periodTicks;
+    reschedule(timerId);
+    return true;
+}
+
+bool TimerWheel::setStretch(TimerId timerId, uint8_t stretch) {
+    if (timerId >= kMaxTimers || !_timers[timerId].used || stretch == 0) {
+        return false;
+    }
+    _timers[timerId].stretch = stretch;
+    reschedule(timerId);
+    return true;
+}
+
+bool TimerWheel::setSuspended(TimerId timerId, bool suspended) {
+    if (timerId >= kMaxTimers || !_timers[timerId].used) {
+        return false;
+    }
+    _timers[timerId].suspended = suspended;
+    return true;
+}
+
+std::chrono::microseconds TimerWheel::takeMaxLateness() {
+    const std::chrono::microseconds maxLateness = _maxLateness;
+    _maxLateness                                = std::chrono::microseconds::zero();
+    return maxLateness;
+}
+
+bool TimerWheel::getStats(TimerId timerId, TimerStats& stats) const {
+    if (timerId >= kMaxTimers || !_timers[timerId].used) {
+        return false;
+    }
+    const TimerEntry& timer = _timers[timerId];
+    stats.nbrOfRuns         = timer.nbrOfRuns;
+    stats.nbrOfSkippedRuns  = timer.nbrOfSkippedRuns;
+    stats.lastLateness      = timer.lastLateness;
+    stats.maxLateness       = timer.maxLateness;
+    stats.maxRunTime        = timer.maxRunTime;
+    stats.averageLateness   = std::chrono::microseconds(
+        timer.nbrOfRuns == 0 ? 0 : timer.totalLateness / timer.nbrOfRuns);
+    return true;
+}
+
+void TimerWheel::printStats() const {
+    tr_info("Timer wheel: tick %" PRIu32 ", up to %" PRIu32 " ticks per event",
+            _currentTick,
+            _maxTicksPerEvent);
+    for (TimerId timerId = 0; timerId < kMaxTimers; timerId++) {
+        TimerStats stats;
+        if (getStats(timerId, stats)) {
+            tr_info("  %s: %" PRIu32 " runs (%" PRIu32 " skipped), lateness avg %" PRIu32
+                    " us, max %" PRIu32 " us, run time max %" PRIu32 " us",
+                    _timers[timerId].name,
+                    stats.nbrOfRuns,
+                    stats.nbrOfSkippedRuns,
+                    static_cast<uint32_t>(stats.averageLateness.count()),
+                    static_cast<uint32_t>(stats.maxLateness.count()),
+                    static_cast<uint32_t>(stats.maxRunTime.count()));
+        }
+    }
+}
+
+uint32_t TimerWheel::getCurrentTick() const { return _currentTick; }
+
+uint32_t TimerWheel::getMaxTicksPerEvent() const { return _maxTicksPerEvent; }
+
+void TimerWheel::onTick() {
+    // the tick event may be late (long task, higher priority thread), all the
+    // ticks elapsed since the last event are processed
+    const uint32_t lastTick = static_cast<uint32_t>(_timer.elapsed_time() / _tickPeriod);
+    uint32_t nbrOfTicks     = 0;
+    while (static_cast<int32_t>(lastTick - _currentTick) > 0) {
+        processTick(_currentTick + 1);
+        nbrOfTicks++;
+    }
+    if (nbrOfTicks > _maxTicksPerEvent) {
+        _maxTicksPerEvent = nbrOfTicks;
+    }
+}
+
+void TimerWheel::processTick(uint32_t tick) {
+    _currentTick = tick;
+    if ((tick & kSlotMask) == 0) {
+        cascade((tick >> kLevelBits) & kSlotMask);
+    }
+
+    // all timers of the slot expire at this tick, timers added or reinserted
+    // while they run always go to another slot
+    TimerId* slot = &_slots[0][tick & kSlotMask];
+    while (*slot != kInvalidTimerId) {
+        const TimerId timerId = *slot;
+        TimerEntry& timer     = _timers[timerId];
+        unlink(timerId);
+
+        if (timer.suspended) {
+            timer.nbrOfSkippedRuns++;
+        } else {
+            _runningTimerId      = timerId;
+            _runningTimerRemoved = false;
+            const std::chrono::microseconds startTime = _timer.elapsed_time();
+            const std::chrono::microseconds lateness =
+                startTime - tick * std::chrono::microseconds(_tickPeriod);
+            timer.callback();
+            const std::chrono::microseconds runTime = _timer.elapsed_time() - startTime;
+            _runningTimerId                         = kInvalidTimerId;
+            if (_runningTimerRemoved) {
+                continue;
+            }
+
+            timer.nbrOfRuns++;
+            timer.lastLateness = lateness;
+            timer.totalLateness += lateness.count();
+            if (lateness > timer.maxLateness) {
+                timer.maxLateness = lateness;
+            }
+            if (lateness > _maxLateness) {
+                _maxLateness = lateness;
+            }
+            if (runTime > timer.maxRunTime) {
+                timer.maxRunTime = runTime;
+            }
+        }
+
+        if (timer.period == 0) {
+            timer.used = false;
+        } else {
+            // computed from the ideal expiry, the timer does not drift
+            timer.expiry += timer.period * timer.stretch;
+            insert(timerId);
+        }
+    }
+}
+
+void TimerWheel::cascade(uint8_t slot) {
+    // detach the list first, timers still far away may go back to this slot
+    TimerId timerId     = _slots[1][slot];
+    _slots[1][slot]     = kInvalidTimerId;
+    _slotTails[1][slot] = kInvalidTimerId;
+    while (timerId != kInvalidTimerId) {
+        const TimerId next = _timers[timerId].next;
+        insert(timerId);
+        timerId = next;
+    }
+}
+
+void TimerWheel::insert(TimerId timerId) {
+    TimerEntry& timer = _timers[timerId];
+    // expiry is never before the current tick
+    const uint32_t delta = timer.expiry - _currentTick;
+    if (delta < kNbrOfSlots) {
+        timer.level = 0;
+        timer.slot  = timer.expiry & kSlotMask;
+    } else {
+        timer.level = 1;
+        timer.slot  = (timer.expiry >> kLevelBits) & kSlotMask;
+    }
+    // timers expiring in the same tick run in insertion order
+    TimerId& tail  = _slotTails[timer.level][timer.slot];
+    timer.previous = tail;
+    timer.next     = kInvalidTimerId;
+    if (tail != kInvalidTimerId) {
+        _timers[tail].next = timerId;
+    } else {
+        _slots[timer.level][timer.slot] = timerId;
+    }
+    tail = timerId;
+}
+
+void TimerWheel::unlink(TimerId timerId) {
+    TimerEntry& timer = _timers[timerId];
+    if (timer.previous != kInvalidTimerId) {
+        _timers[timer.previous].next = timer.next;
+    } else {
+        _slots[timer.level][timer.slot] = timer.next;
+    }
+    if (timer.next != kInvalidTimerId) {
+        _timers[timer.next].previous = timer.previous;
+    } else {
+        _slotTails[timer.level][timer.slot] = timer.previous;
+    }
+}
+
+void TimerWheel::reschedule(TimerId timerId) {
+    // a running timer is inserted again with its new period after its callback
+    TimerEntry& timer     = _timers[timerId];
+    const uint32_t expiry = _currentTick + timer.period * timer.stretch;
+    if (timerId != _runningTimerId && static_cast<int32_t>(timer.expiry - expiry) > 0) {
+        unlink(timerId);
+        timer.expiry = expiry;
+        insert(timerId);
+    }
+}
+
+uint32_t TimerWheel::toTicks(const std::chrono::milliseconds& duration) const {
+    return static_cast<uint32_t>(duration / _tickPeriod);
+}
+
+uint32_t TimerWheel::toPeriodTicks(const std::chrono::milliseconds& period) const {
+    const uint32_t periodTicks = toTicks(period);
+    if (periodTicks == 0 && period.count() > 0) {
+        return 1;
+    }
+    return periodTicks;
+}
+
+}  // namespace bike_computer
@@ -0,0 +1,158 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file timer_wheel.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Hierarchical timer wheel running periodic tasks on an event queue
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "EventQueue.h"
+#include "mbed.h"
+
+namespace bike_computer {
+
+enum class TimerAlignment : uint8_t {
+    // the first run happens offset after the timer is added
+    Relative = 0,
+    // the timer runs at the ticks where (tick - offset) is a multiple of the
+    // period: timers with the same period and offset always run in the same tick
+    Absolute
+};
+
+// lateness is measured from the ideal start time of each run
+struct TimerStats {
+    uint32_t nbrOfRuns;
+    uint32_t nbrOfSkippedRuns;
+    std::chrono::microseconds lastLateness;
+    std::chrono::microseconds maxLateness;
+    std::chrono::microseconds averageLateness;
+    std::chrono::microseconds maxRunTime;
+};
+
+// a single periodic event is posted on the event queue, whatever the number of
+// timers. Adding, removing and firing a timer costs O(1): timers expiring in
+// less than kNbrOfSlots ticks are stored in the slot of their expiry tick,
+// later ones in the slot of their group of kNbrOfSlots ticks and they are moved
+// to the first level when their group starts. All methods must be called from
+// the thread dispatching the event queue (or before the queue is dispatched).
+class TimerWheel {
+   public:
+    using TimerId                            = uint8_t;
+    static constexpr TimerId kInvalidTimerId = 0xFF;
+    static constexpr uint8_t kMaxTimers      = 32;
+
+    TimerWheel(EventQueue& eventQueue,  // NOLINT(runtime/references)
+               const std::chrono::milliseconds& tickPeriod);
+
+    // make the class non copyable
+    TimerWheel(TimerWheel&)            = delete;
+    TimerWheel& operator=(TimerWheel&) = delete;
+
+    // post the tick event, returns false if it could not be posted
+    bool start();
+    void stop();
+
+    // period and offset are rounded down to a number of ticks, a period shorter
+    // than one tick runs every tick, a null period makes a one-shot timer
+    // (removed after it ran), returns kInvalidTimerId if all timers are in use
+    TimerId addTimer(const char* name,
+                     Callback<void()> callback,
+                     const std::chrono::milliseconds& period,
+                     const std::chrono::milliseconds& offset,
+                     TimerAlignment alignment = TimerAlignment::Relative);
+    bool removeTimer(TimerId timerId);
+    // the new period applies from the next run, which is brought forward if the
+    // new period ends before it (a timer cannot become a one-shot timer)
+    bool setPeriod(TimerId timerId, const std::chrono::milliseconds& period);
+
+    // used for degrading the timers under overload: a stretched timer runs
+    // every stretch periods, a suspended timer keeps its schedule but its
+    // callback is skipped
+    bool setStretch(TimerId timerId, uint8_t stretch);
+    bool setSuspended(TimerId timerId, bool suspended);
+
+    // largest lateness of a run since the last call
+    std::chrono::microseconds takeMaxLateness();
+
+    bool getStats(TimerId timerId, TimerStats& stats) const;  // NOLINT
+    void printStats() const;
+
+    // last tick processed
+    uint32_t getCurrentTick() const;
+    // largest number of ticks processed by one tick event (1 when never late)
+    uint32_t getMaxTicksPerEvent() const;
+
+   private:
+    static constexpr uint8_t kLevelBits   = 6;
+    static constexpr uint8_t kNbrOfSlots  = 1 << kLevelBits;
+    static constexpr uint32_t kSlotMask   = kNbrOfSlots - 1;
+    static constexpr uint8_t kNbrOfLevels = 2;
+
+    struct TimerEntry {
+        Callback<void()> callback;
+        const char* name;
+        // expressed in ticks
+        uint32_t period;
+        uint32_t expiry;
+        TimerId previous;
+        TimerId next;
+        uint8_t level;
+        uint8_t slot;
+        bool used;
+        uint8_t stretch;
+        bool suspended;
+        // drift statistics
+        uint32_t nbrOfRuns;
+        uint32_t nbrOfSkippedRuns;
+        std::chrono::microseconds lastLateness;
+        std::chrono::microseconds maxLateness;
+        uint64_t totalLateness;
+        std::chrono::microseconds maxRunTime;
+    };
+
+    void onTick();
+    void processTick(uint32_t tick);
+    void cascade(uint8_t slot);
+    void insert(TimerId timerId);
+    void unlink(TimerId timerId);
+    uint32_t toTicks(const std::chrono::milliseconds& duration) const;
+    // at least one tick for a non null period
+    uint32_t toPeriodTicks(const std::chrono::milliseconds& period) const;
+    // brings the next run forward if it is later than one (stretched) period
+    void reschedule(TimerId timerId);
+
+    EventQueue& _eventQueue;
+    const std::chrono::milliseconds _tickPeriod;
+    Event<void()> _tickEvent;
+    // time base of the ticks (tick n ideally starts at n * _tickPeriod)
+    Timer _timer;
+    TimerEntry _timers[kMaxTimers]                = {};
+    TimerId _slots[kNbrOfLevels][kNbrOfSlots]     = {};
+    TimerId _slotTails[kNbrOfLevels][kNbrOfSlots] = {};
+    uint32_t _currentTick                         = UINT32_MAX;
+    uint32_t _maxTicksPerEvent                    = 0;
+    std::chrono::microseconds _maxLateness        = std::chrono::microseconds::zero();
+    // a timer may remove itself from its callback
+    TimerId _runningTimerId   = kInvalidTimerId;
+    bool _runningTimerRemoved = false;
+};
+
+}  // namespace bike_computer
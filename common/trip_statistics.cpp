@@ -0,0 +1,148 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file trip_statistics.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Trip statistics implementation
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "common/trip_statistics.hpp"
+
+#include "common/constants.hpp"
+
+namespace bike_computer {
+
+// below this speed, the bike is considered as stopped (km / h)
+static constexpr float kMinMovingSpeed = 1.0f;
+// upper limits of the zones, the last zone has no upper limit
+static constexpr float kSpeedZoneLimits[kNbrOfSpeedZones - 1] = {15.0f, 25.0f, 35.0f};
+// expressed in pedal turns / min
+static constexpr float kCadenceZoneLimits[kNbrOfCadenceZones - 1] = {
+    60.0f, 80.0f, 100.0f};
+
+TripStatistics::TripStatistics() {
+    reset(std::chrono::microseconds::zero());
+    _aggregates.cadenceZone = getCadenceZone(kInitialPedalRotationTime);
+}
+
+void TripStatistics::onGearChanged(const std::chrono::microseconds& currentTime,
+                                   float speed) {
+    core_util_critical_section_enter();
+    accumulate(_aggregates, currentTime);
+    setSpeed(speed);
+    core_util_critical_section_exit();
+}
+
+void TripStatistics::onPedalRotationChanged(
+    const std::chrono::microseconds& currentTime,
+    float speed,
+    const std::chrono::milliseconds& pedalRotationTime) {
+    const uint8_t cadenceZone = getCadenceZone(pedalRotationTime);
+    core_util_critical_section_enter();
+    accumulate(_aggregates, currentTime);
+    setSpeed(speed);
+    _aggregates.cadenceZone = cadenceZone;
+    core_util_critical_section_exit();
+}
+
+void TripStatistics::reset(const std::chrono::microseconds& currentTime) {
+    core_util_critical_section_enter();
+    const uint8_t cadenceZone = _aggregates.cadenceZone;
+    _aggregates               = {};
+    _aggregates.lastTime      = currentTime;
+    _aggregates.cadenceZone   = cadenceZone;
+    core_util_critical_section_exit();
+}
+
+void TripStatistics::getSnapshot(const std::chrono::microseconds& currentTime,
+                                 TripSnapshot& snapshot) const {
+    // work on a copy, so that the critical section stays short
+    core_util_critical_section_enter();
+    Aggregates aggregates = _aggregates;
+    core_util_critical_section_exit();
+
+    accumulate(aggregates, currentTime);
+
+    const float movingHours = static_cast<float>(aggregates.movingTime.count()) / 3.6e9f;
+    snapshot.averageSpeed =
+        movingHours > 0.0f ? aggregates.movingDistance / movingHours : 0.0f;
+    snapshot.maxSpeed       = aggregates.maxSpeed;
+    snapshot.movingDistance = aggregates.movingDistance;
+    snapshot.movingTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(aggregates.movingTime);
+    for (uint8_t zone = 0; zone < kNbrOfSpeedZones; zone++) {
+        snapshot.timeInSpeedZone[zone] =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                aggregates.timeInSpeedZone[zone]);
+    }
+    for (uint8_t zone = 0; zone < kNbrOfCadenceZones; zone++) {
+        snapshot.timeInCadenceZone[zone] =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                aggregates.timeInCadenceZone[zone]);
+    }
+}
+
+uint8_t TripStatistics::getSpeedZone(float speed) {
+    uint8_t zone = 0;
+    while (zone < kNbrOfSpeedZones - 1 && speed >= kSpeedZoneLimits[zone]) {
+        zone++;
+    }
+    return zone;
+}
+
+uint8_t TripStatistics::getCadenceZone(
+    const std::chrono::milliseconds& pedalRotationTime) {
+    if (pedalRotationTime.count() <= 0) {
+        // zero cadence, the crank stopped turning
+        return 0;
+    }
+    const float cadence = 60000.0f / static_cast<float>(pedalRotationTime.count());
+    uint8_t zone        = 0;
+    while (zone < kNbrOfCadenceZones - 1 && cadence >= kCadenceZoneLimits[zone]) {
+        zone++;
+    }
+    return zone;
+}
+
+void TripStatistics::accumulate(Aggregates& aggregates,
+                                const std::chrono::microseconds& currentTime) {
+    if (currentTime <= aggregates.lastTime) {
+        return;
+    }
+    const std::chrono::microseconds elapsedTime = currentTime - aggregates.lastTime;
+    aggregates.lastTime                         = currentTime;
+    if (aggregates.currentSpeed < kMinMovingSpeed) {
+        return;
+    }
+    aggregates.movingTime += elapsedTime;
+    aggregates.movingDistance +=
+        aggregates.currentSpeed * static_cast<float>(elapsedTime.count()) / 3.6e9f;
+    aggregates.timeInSpeedZone[aggregates.speedZone] += elapsedTime;
+    aggregates.timeInCadenceZone[aggregates.cadenceZone] += elapsedTime;
+}
+
+void TripStatistics::setSpeed(float speed) {
+    _aggregates.currentSpeed = speed;
+    _aggregates.speedZone    = getSpeedZone(speed);
+    if (speed > _aggregates.maxSpeed) {
+        _aggregates.maxSpeed = speed;
+    }
+}
+
+}  // namespace bike_computer
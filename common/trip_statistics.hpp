@@ -0,0 +1,103 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file trip_statistics.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Trip statistics (average and max speed, moving time, time spent in
+ *        speed and cadence zones), updated incrementally on gear and pedal
+ *        events
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "mbed.h"
+
+namespace bike_computer {
+
+static constexpr uint8_t kNbrOfSpeedZones   = 4;
+static constexpr uint8_t kNbrOfCadenceZones = 4;
+
+// statistics at a given time
+struct TripSnapshot {
+    // expressed in km / h, the average speed is computed over the moving time
+    float averageSpeed;
+    float maxSpeed;
+    // expressed in km
+    float movingDistance;
+    std::chrono::milliseconds movingTime;
+    // zones only account moving time
+    std::chrono::milliseconds timeInSpeedZone[kNbrOfSpeedZones];
+    std::chrono::milliseconds timeInCadenceZone[kNbrOfCadenceZones];
+};
+
+class TripStatistics {
+   public:
+    TripStatistics();
+
+    // make the class non copyable
+    TripStatistics(TripStatistics&)            = delete;
+    TripStatistics& operator=(TripStatistics&) = delete;
+
+    // methods called with the speed computed by the speedometer after each
+    // event, the time elapsed since the previous event is accounted at the
+    // previous speed and cadence (constant time, no allocation)
+    void onGearChanged(const std::chrono::microseconds& currentTime, float speed);
+    void onPedalRotationChanged(const std::chrono::microseconds& currentTime,
+                                float speed,
+                                const std::chrono::milliseconds& pedalRotationTime);
+
+    // method called for resetting the statistics (together with the speedometer,
+    // the speed is zero until the next event)
+    void reset(const std::chrono::microseconds& currentTime);
+
+    // statistics including the time elapsed since the last event, may be called
+    // from any thread
+    void getSnapshot(const std::chrono::microseconds& currentTime,
+                     TripSnapshot& snapshot) const;  // NOLINT(runtime/references)
+
+    // zone index for a given speed (km / h) or pedal rotation time
+    static uint8_t getSpeedZone(float speed);
+    static uint8_t getCadenceZone(const std::chrono::milliseconds& pedalRotationTime);
+
+   private:
+    struct Aggregates {
+        std::chrono::microseconds lastTime;
+        float currentSpeed;
+        uint8_t speedZone;
+        uint8_t cadenceZone;
+        float maxSpeed;
+        float movingDistance;
+        std::chrono::microseconds movingTime;
+        std::chrono::microseconds timeInSpeedZone[kNbrOfSpeedZones];
+        std::chrono::microseconds timeInCadenceZone[kNbrOfCadenceZones];
+    };
+
+    // account the time elapsed since aggregates.lastTime
+    static void accumulate(Aggregates& aggregates,  // NOLINT(runtime/references)
+                           const std::chrono::microseconds& currentTime);
+    void setSpeed(float speed);
+
+    // updated in critical sections, the events and the reset are not handled
+    // by the same thread
+    Aggregates _aggregates;
+};
+
+}  // namespace bike_computer
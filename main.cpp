@@ -3,10 +3,14 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <algorithm>
 #include <ctime>
+#include <new>
 
 #include "FlashIAPBlockDevice.h"
 #include "common/constants.hpp"
+#include "common/heap_monitor.hpp"
+#include "common/startup_timeline.hpp"
 #include "mbed-os/mbed.h"
 #include "mbed-trace/mbed_trace.h"
 #include "memory_logger.hpp"
@@ -23,6 +27,162 @@
 #endif  // MBED_CONF_MBED_TRACE_ENABLE
 
 #if !MBED_TEST_MODE
+// all bike systems provide start(), stop(), onReset() and printStatistics(), the
+// variant is selected at boot (bike-system-variant)
+static constexpr uint8_t kBikeSystemVariant = MBED_CONF_APP_BIKE_SYSTEM_VARIANT;
+static constexpr uint32_t kBenchmarkNbrOfPresses = MBED_CONF_APP_BENCHMARK_NBR_OF_PRESSES;
+// scripted input of the benchmark: a press every kBenchmarkResetPeriod plus a
+// pseudo-random delay, the phase of the presses relative to the periodic tasks
+// drifts. Presses are never closer than the reset polling period of the static
+// variants (800 ms), otherwise two presses would be handled as one
+static constexpr std::chrono::milliseconds kBenchmarkResetPeriod = 850ms;
+static constexpr uint32_t kBenchmarkResetJitter                  = 150;  // ms
+static constexpr uint32_t kBenchmarkSeed                         = 0x2545F491;
+// the loaded runs add a thread at the priority of the bike system, busy half of
+// the time
+static constexpr std::chrono::milliseconds kBenchmarkLoadBusyTime = 4ms;
+static constexpr std::chrono::milliseconds kBenchmarkLoadIdleTime = 4ms;
+
+// the bike systems hold latency histograms and the input log, they are too large
+// for the main stack: each run constructs its system in a static storage sized
+// for the largest variant
+static constexpr size_t kBikeSystemSize =
+    std::max({sizeof(static_scheduling::BikeSystem),
+              sizeof(static_scheduling_with_event::BikeSystem),
+              sizeof(multi_tasking::BikeSystem)});
+static constexpr size_t kBikeSystemAlignment =
+    std::max({alignof(static_scheduling::BikeSystem),
+              alignof(static_scheduling_with_event::BikeSystem),
+              alignof(multi_tasking::BikeSystem)});
+alignas(kBikeSystemAlignment) static uint8_t bikeSystemStorage[kBikeSystemSize];
+
+// xorshift32, the same sequence of presses is used for all runs
+static uint32_t nextRandom(uint32_t& state) {  // NOLINT(runtime/references)
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+struct BenchmarkLoad {
+    volatile bool stopFlag = false;
+
+    void run() {
+        Timer timer;
+        timer.start();
+        while (!stopFlag) {
+            const std::chrono::microseconds busyStartTime = timer.elapsed_time();
+            while (timer.elapsed_time() - busyStartTime < kBenchmarkLoadBusyTime) {
+            }
+            ThisThread::sleep_for(kBenchmarkLoadIdleTime);
+        }
+    }
+};
+
+// injects the scripted presses from a Timeout (interrupt context), as a press
+// of the button, and signals when kBenchmarkNbrOfPresses were injected
+struct BenchmarkPresses {
+    static constexpr uint32_t kDoneFlag = (1UL << 0);
+
+    Callback<void()> press;
+    Timeout timeout;
+    EventFlags eventFlags;
+    uint32_t randomState  = kBenchmarkSeed;
+    uint32_t nbrOfPresses = 0;
+
+    void start() { scheduleNext(); }
+
+    void waitForEnd() { eventFlags.wait_any(kDoneFlag); }
+
+    void scheduleNext() {
+        timeout.attach(callback(this, &BenchmarkPresses::onTimeout),
+                       kBenchmarkResetPeriod +
+                           std::chrono::milliseconds(nextRandom(randomState) %
+                                                     kBenchmarkResetJitter));
+    }
+
+    void onTimeout() {
+        press();
+        nbrOfPresses++;
+        if (nbrOfPresses < kBenchmarkNbrOfPresses) {
+            scheduleNext();
+        } else {
+            eventFlags.set(kDoneFlag);
+        }
+    }
+};
+
+// the system is constructed again when it returns
+template <typename TBikeSystem, void (TBikeSystem::*kStart)()>
+static void runBikeSystem() {
+    while (true) {
+        TBikeSystem* bikeSystem = new (bikeSystemStorage) TBikeSystem();
+        (bikeSystem->*kStart)();
+        bikeSystem->~TBikeSystem();
+    }
+}
+
+// run the system for kBenchmarkNbrOfPresses scripted reset presses and print its
+// statistics (reset response time percentiles among them)
+template <typename TBikeSystem, void (TBikeSystem::*kStart)()>
+static void benchmarkBikeSystem(const char* name, bool loaded) {
+    tr_info("Benchmark of %s (%s) with %" PRIu32 " presses",
+            name,
+            loaded ? "loaded" : "idle",
+            kBenchmarkNbrOfPresses);
+    // the load thread is started first, its stack is allocated before the bike
+    // system enters its heap steady state
+    BenchmarkLoad benchmarkLoad;
+    Thread loadThread(osPriorityNormal, OS_STACK_SIZE, nullptr, "BenchmarkLoad");
+    if (loaded) {
+        loadThread.start(callback(&benchmarkLoad, &BenchmarkLoad::run));
+    }
+
+    TBikeSystem& bikeSystem = *new (bikeSystemStorage) TBikeSystem();
+    Thread thread(osPriorityNormal, MBED_CONF_APP_MAIN_STACK_SIZE, nullptr, name);
+    thread.start(callback(&bikeSystem, kStart));
+
+    BenchmarkPresses benchmarkPresses;
+    benchmarkPresses.press = callback(&bikeSystem, &TBikeSystem::onReset);
+    benchmarkPresses.start();
+    benchmarkPresses.waitForEnd();
+    // the last press must be handled before the statistics are printed
+    ThisThread::sleep_for(kBenchmarkResetPeriod);
+
+    if (loaded) {
+        benchmarkLoad.stopFlag = true;
+        loadThread.join();
+    }
+    tr_info("Benchmark of %s (%s) done", name, loaded ? "loaded" : "idle");
+    bikeSystem.printStatistics();
+    bikeSystem.stop();
+    thread.join();
+    bikeSystem.~TBikeSystem();
+}
+
+// log thread statistics
+static void printThreadStatistics() {
+    static advembsof::MemoryLogger memoryLogger;
+    memoryLogger.getAndPrintThreadStatistics();
+    memoryLogger.printDiffs();
+}
+
+#if (USE_USB_SERIAL_UC == 1) && defined(HEADER_ADDR)
+// the update client lives until the next reset
+static void startUpdateClient() {
+    bike_computer::HeapTagScope heapTagScope(bike_computer::HeapTag::UpdateClient);
+    static FlashIAPBlockDevice flashIAPBlockDevice(MBED_ROM_START, MBED_ROM_SIZE);
+    static update_client::USBSerialUC usbSerialUpdateClient(flashIAPBlockDevice);
+    update_client::UCErrorCode rc = usbSerialUpdateClient.start();
+
+    if (rc != update_client::UCErrorCode::UC_ERR_NONE) {
+        tr_error("Cannot initialize update client: %d", rc);
+    } else {
+        tr_info("Update client started");
+    }
+}
+#endif
+
 int main() {
     // Initialise the digital pin LED1 as an output
     // #ifdef LED1
@@ -31,35 +191,62 @@ int main() {
     //     bool led = false;
     // #endif
 
-    // log thread statistics
-    advembsof::MemoryLogger memoryLogger;
-    memoryLogger.getAndPrintThreadStatistics();
-    memoryLogger.printDiffs();
+    // the startup timeline is measured from here
+    bike_computer::StartupTimeline& startupTimeline =
+        bike_computer::StartupTimeline::getInstance();
 
 #if defined(MBED_CONF_MBED_TRACE_ENABLE)
     mbed_trace_init();
 #endif
+
+    // not needed for the first frame, they run once it is shown, before the bike
+    // system enters its heap steady state
+    startupTimeline.defer("ThreadStatistics", printThreadStatistics);
 #if (USE_USB_SERIAL_UC == 1) && defined(HEADER_ADDR)
-    FlashIAPBlockDevice flashIAPBlockDevice(MBED_ROM_START, MBED_ROM_SIZE);
-    update_client::USBSerialUC usbSerialUpdateClient(flashIAPBlockDevice);
-    update_client::UCErrorCode rc = usbSerialUpdateClient.start();
+    startupTimeline.defer("UpdateClient", startUpdateClient);
+#endif
 
-    if (rc != update_client::UCErrorCode::UC_ERR_NONE) {
-        tr_error("Cannot initialize update client: %d", rc);
-    } else {
-        tr_info("Update client started");
+    if (kBenchmarkNbrOfPresses > 0) {
+        // all variants run one after the other with the same scripted input, idle
+        // and then loaded
+        static constexpr bool kLoadedRuns[] = {false, true};
+        for (bool loaded : kLoadedRuns) {
+            benchmarkBikeSystem<static_scheduling::BikeSystem,
+                                &static_scheduling::BikeSystem::start>("StaticScheduling",
+                                                                       loaded);
+            benchmarkBikeSystem<static_scheduling::BikeSystem,
+                                &static_scheduling::BikeSystem::startWithEventQueue>(
+                "StaticSchedulingEventQueue", loaded);
+            benchmarkBikeSystem<static_scheduling_with_event::BikeSystem,
+                                &static_scheduling_with_event::BikeSystem::start>(
+                "StaticSchedulingWithEvent", loaded);
+            benchmarkBikeSystem<multi_tasking::BikeSystem,
+                                &multi_tasking::BikeSystem::start>("MultiTasking",
+                                                                   loaded);
+        }
+        tr_info("Benchmark done");
+        while (true) {
+            ThisThread::sleep_for(BLINKING_RATE);
+        }
     }
-#endif
 
-    while (true) {
-        // static_scheduling::BikeSystem bikeSystem;
-        // static_scheduling_with_event::BikeSystem bikeSystem_with_event;
-        multi_tasking::BikeSystem bike_system_multi_tasking;
-
-        bike_system_multi_tasking.start();
-        // bikeSystem_with_event.start();
-        // bikeSystem.start();
-        // bikeSystem.startWithEventQueue();
+    switch (kBikeSystemVariant) {
+        case 0:
+            runBikeSystem<static_scheduling::BikeSystem,
+                          &static_scheduling::BikeSystem::start>();
+            break;
+        case 1:
+            runBikeSystem<static_scheduling::BikeSystem,
+                          &static_scheduling::BikeSystem::startWithEventQueue>();
+            break;
+        case 2:
+            runBikeSystem<static_scheduling_with_event::BikeSystem,
+                          &static_scheduling_with_event::BikeSystem::start>();
+            break;
+        case 3:
+        default:
+            runBikeSystem<multi_tasking::BikeSystem, &multi_tasking::BikeSystem::start>();
+            break;
     }
 }
 #endif
@@ -28,7 +28,9 @@
 #include <cstdint>
 
 #include "Callback.h"
+#include "bike_system_stats.hpp"
 #include "gear_device.hpp"
+#include "glyph_atlas.hpp"
 #include "mbed_trace.h"
 #if MBED_CONF_MBED_TRACE_ENABLE
 #define TRACE_GROUP "BikeSystem"
@@ -41,21 +43,88 @@ static constexpr std::chrono::milliseconds kDisplayTaskDelay                = 30
 static constexpr std::chrono::milliseconds kTemperatureTaskPeriod            = 1600ms;
 static constexpr std::chrono::milliseconds kTemperatureTaskDelay             = 1100ms;
 static constexpr std::chrono::milliseconds kMajorCycleDuration               = 1600ms;
+static constexpr std::chrono::milliseconds kTimerWheelTickPeriod(
+    MBED_CONF_APP_TIMER_WHEEL_TICK_PERIOD);
+static constexpr std::chrono::seconds kModePausedDelay(MBED_CONF_APP_MODE_PAUSED_DELAY);
+static constexpr std::chrono::seconds kModeParkedDelay(MBED_CONF_APP_MODE_PARKED_DELAY);
+static constexpr std::chrono::milliseconds kOverloadLatenessThreshold(
+    MBED_CONF_APP_OVERLOAD_LATENESS_THRESHOLD);
+static constexpr std::chrono::milliseconds kWatchdogTimeout(
+    MBED_CONF_APP_WATCHDOG_TIMEOUT);
+static constexpr std::chrono::milliseconds kHeartbeatPeriod    = 1000ms;
+static constexpr std::chrono::milliseconds kHeartbeatTolerance = 2000ms;
+static constexpr std::chrono::seconds kStackProfilerSoakDuration(
+    MBED_CONF_APP_STACK_PROFILER_SOAK_DURATION);
+
+// longest time between two runs of a task of the mode table
+static std::chrono::milliseconds getSupervisionPeriod(
+    const bike_computer::ModeTask& task) {
+    std::chrono::milliseconds period = std::chrono::milliseconds::zero();
+    for (uint8_t mode = 0; mode < bike_computer::kNbrOfModes; mode++) {
+        if (task.periods[mode] > period) {
+            period = task.periods[mode];
+        }
+    }
+    return period * (1 << bike_computer::OverloadManager::kMaxLevel);
+}
+
+bool BikeSystem::_devicesInitialized = false;
 
 BikeSystem::BikeSystem()
     :
       _eventQueuePeriodic(),
       _eventQueueISR(),
-      _ThreadISR(osPriorityBelowNormal, OS_STACK_SIZE, nullptr, "ISRThread"), 
+      _eventQueuePeriodicMonitor("PeriodicQueue"),
+      _eventQueueISRMonitor("ISRQueue"),
+      _ThreadISR(osPriorityBelowNormal,
+                 MBED_CONF_APP_ISR_THREAD_STACK_SIZE,
+                 nullptr,
+                 "ISRThread"),
       _timer(),
-      _gearDevice(_eventQueuePeriodic, callback(this, &BikeSystem::onGearEvent)),
-      _pedalDevice(_eventQueuePeriodic, callback(this, &BikeSystem::onPedalEvent)),
-      _resetDevice(callback(this, &BikeSystem::onReset)),
+      _inputRecorder(),
+      _inputReplayer(callback(this, &BikeSystem::injectInput)),
+      _gearDevice(_eventQueuePeriodic,
+                  callback(this, &BikeSystem::onGearEvent),
+                  &_eventQueuePeriodicMonitor,
+                  &_inputRecorder),
+      _pedalDevice(_eventQueuePeriodic,
+                   callback(this, &BikeSystem::onPedalEvent),
+                   &_eventQueuePeriodicMonitor,
+                   &_inputRecorder),
+#if defined(MBED_CONF_APP_CRANK_SENSOR_PIN)
+      _crankSensorDevice(MBED_CONF_APP_CRANK_SENSOR_PIN,
+                         _eventQueuePeriodic,
+                         callback(this, &BikeSystem::onPedalEvent),
+                         &_eventQueuePeriodicMonitor),
+#endif  // defined(MBED_CONF_APP_CRANK_SENSOR_PIN)
+      _resetDevice(callback(this, &BikeSystem::onReset),
+                   callback(this, &BikeSystem::onTripReset)),
       _displayDevice(),
+      _displayRenderer(_speedHistory),
       _speedometer(_timer),
+      _kvBlockDevice(MBED_ROM_START + MBED_CONF_APP_KV_STORE_ADDRESS,
+                     MBED_CONF_APP_KV_STORE_SIZE),
+      _kvStore(_kvBlockDevice, 0, MBED_CONF_APP_KV_STORE_SIZE),
+      _odometer(_kvStore),
       _sensorDevice(),
+      _temperatureReadTask(_eventQueuePeriodic, "TemperatureRead"),
       _taskLogger(),
-      _cpuLogger(_timer) {}
+      _cpuLogger(_timer),
+      _timerWheel(_eventQueuePeriodic, kTimerWheelTickPeriod),
+      _modeManager(
+          _timerWheel, _speedometer, _timer, kModePausedDelay, kModeParkedDelay),
+      _overloadManager(_timerWheel, kOverloadLatenessThreshold),
+#if defined(MBED_TEST_MODE) || (MBED_CONF_APP_BENCHMARK_NBR_OF_PRESSES > 0)
+      _simulatedWatchdog(_timer),
+      _taskSupervisor(_timer, _simulatedWatchdog, kWatchdogTimeout),
+#else
+      _taskSupervisor(_timer, kWatchdogTimeout),
+#endif  // defined(MBED_TEST_MODE) || (MBED_CONF_APP_BENCHMARK_NBR_OF_PRESSES > 0)
+      _stackProfiler(MBED_CONF_APP_STACK_PROFILER_MARGIN) {
+    _periodicTraceChannel =
+        bike_computer::BinaryTrace::getInstance().getChannel("PeriodicThread");
+    _isrTraceChannel = bike_computer::BinaryTrace::getInstance().getChannel("ISRThread");
+}
 
       //ajouter le memorylogger pour faire getAndPrintStatistics()
       //comme dans le codelab multi-tasking ajouter aussi un printDiff()
@@ -65,52 +134,127 @@ void BikeSystem::start() {
 
     init();
 
-
-    auto startTime = _timer.elapsed_time();               // schedule the task to the event queue
-    
-    // Schedule the temperatureTask
-    Event<void()> temperatureTaskEvent(&_eventQueuePeriodic,
-                                       callback(this, &BikeSystem::temperatureTask));
-    temperatureTaskEvent.delay(kTemperatureTaskDelay);
-    temperatureTaskEvent.period(kTemperatureTaskPeriod);
-    temperatureTaskEvent.post();
-
-
-    // Schedule the displayTask
-    Event<void()> displayTaskEvent(&_eventQueuePeriodic,
-                                    callback(this, &BikeSystem::displayTask));
-    displayTaskEvent.delay(kDisplayTaskDelay);
-    displayTaskEvent.period(kDisplayTaskPeriod);
-    displayTaskEvent.post();
-
+    // the first frame shows the restored values without waiting for the display
+    // task, it is rendered while the tasks are registered
+    const DisplaySnapshot firstSnapshot = {_gearDevice.getCurrentGear(),
+                                           _speedometer.getCurrentSpeed(),
+                                           _speedometer.getDistance(),
+                                           _currentTemperature};
+    _displayRenderer.publish(firstSnapshot);
+
+
+    // all periodic tasks are run by the timer wheel, a single periodic event is
+    // posted on the queue. The sensor and display tasks are slowed down when the
+    // bike is paused or parked, their periods per mode are given by the task table
+    // (riding, paused, parked).
+    const bike_computer::ModeTask modeTasks[] = {
+        {"Temperature",
+         callback(this, &BikeSystem::temperatureTask),
+         {kTemperatureTaskPeriod, 8s, 60s},
+         kTemperatureTaskDelay},
+        {"Display",
+         callback(this, &BikeSystem::displayTask),
+         {kDisplayTaskPeriod, 3200ms, 16s},
+         kDisplayTaskDelay}};
+    if (!_modeManager.start(modeTasks, sizeof(modeTasks) / sizeof(modeTasks[0]))) {
+        tr_error("Cannot register the tasks with the mode manager");
+    }
 
     tr_info("All tasks posted");
 
+    // the heartbeat budget of a task covers its longest period (parked mode,
+    // highest overload level). A task blocked on the periodic thread is detected
+    // earlier since it also stops the heartbeat of the thread.
+    _temperatureHeartbeatId = _taskSupervisor.registerTask(
+        "Temperature", getSupervisionPeriod(modeTasks[0]), kHeartbeatTolerance);
+    _displayHeartbeatId = _taskSupervisor.registerTask(
+        "Display", getSupervisionPeriod(modeTasks[1]), kHeartbeatTolerance);
+    _periodicHeartbeatId = _taskSupervisor.registerTask(
+        "PeriodicThread", kHeartbeatPeriod, kHeartbeatTolerance);
+    _timerWheel.addTimer("Heartbeat",
+                         callback(this, &BikeSystem::heartbeatTask),
+                         kHeartbeatPeriod,
+                         kHeartbeatPeriod);
+
+    // the display and sensor refresh run less often under overload, the
+    // gear, pedal and reset events are not periodic and are never degraded
+    _overloadManager.addTask(_modeManager.getTimerId(0),
+                             bike_computer::TaskCriticality::Degradable);
+    _overloadManager.addTask(_modeManager.getTimerId(1),
+                             bike_computer::TaskCriticality::Degradable);
 
     #if !MBED_TEST_MODE
-        // Memory logger task
-    Event<void()> memoryLoggerEvent(
-        &_eventQueuePeriodic, callback(&_memoryLogger, &advembsof::MemoryLogger::printDiffs));
-    memoryLoggerEvent.period(kMajorCycleDuration);
-    memoryLoggerEvent.delay(kMajorCycleDuration);
-    memoryLoggerEvent.post();
-
-
+    // the statistics are printed together, at the start of each major cycle, they
+    // are skipped under overload
+    bike_computer::ThreadCPULogger& threadCPULogger =
+        bike_computer::ThreadCPULogger::getInstance();
+    threadCPULogger.start();
+    bike_computer::HeapMonitor& heapMonitor = bike_computer::HeapMonitor::getInstance();
+    const struct {
+        const char* name;
+        Callback<void()> callback;
+    } loggingTasks[] = {
+        {"MemoryLogger", callback(&_memoryLogger, &advembsof::MemoryLogger::printDiffs)},
+        {"CPULogger", callback(&_cpuLogger, &advembsof::CPULogger::printStats)},
+        // per-thread cpu usage, context switches and preemptions
+        {"ThreadCPULogger",
+         callback(&threadCPULogger, &bike_computer::ThreadCPULogger::printStats)},
+        // heap usage per subsystem and event queue occupancy
+        {"HeapMonitor", callback(&heapMonitor, &bike_computer::HeapMonitor::printStats)},
+        {"EventQueueStats", callback(this, &BikeSystem::printEventQueueStats)},
+        {"TripStatistics", callback(this, &BikeSystem::printTripStatistics)},
+        {"TimerWheelStats",
+         callback(&_timerWheel, &bike_computer::TimerWheel::printStats)},
+        {"TaskSupervisorStats",
+         callback(&_taskSupervisor, &bike_computer::TaskSupervisor::printStats)}};
+    for (const auto& loggingTask : loggingTasks) {
+        _overloadManager.addTask(
+            _timerWheel.addTimer(loggingTask.name,
+                                 loggingTask.callback,
+                                 kMajorCycleDuration,
+                                 kMajorCycleDuration,
+                                 bike_computer::TimerAlignment::Absolute),
+            bike_computer::TaskCriticality::Optional);
+    }
 
-    Event<void()> printStatsEvent(
-        &_eventQueuePeriodic, callback(&_cpuLogger, &advembsof::CPULogger::printStats));
-    printStatsEvent.delay(kMajorCycleDuration);
-    printStatsEvent.period(kMajorCycleDuration);
-    printStatsEvent.post();
+    // stack peaks are reported once, after the soak duration
+    if (kStackProfilerSoakDuration.count() > 0) {
+        _timerWheel.addTimer(
+            "StackProfiler",
+            callback(&_stackProfiler, &bike_computer::StackProfiler::printReport),
+            std::chrono::milliseconds::zero(),
+            kStackProfilerSoakDuration);
+    }
     #endif
 
+    if (!_overloadManager.start()) {
+        tr_error("Cannot start the overload manager");
+    }
+
+    _eventQueuePeriodicMonitor.recordPeriodicPost(_timerWheel.start());
 
     _ThreadISR.start(callback(&_eventQueueISR, &EventQueue::dispatch_forever));
 
+    // the heartbeats are checked from the ISR thread, which runs no supervised task
+    if (!_taskSupervisor.start()) {
+        tr_error("Cannot start the watchdog");
+    }
+    _supervisorCheckId = _eventQueueISR.call_every(
+        bike_computer::TaskSupervisor::kCheckPeriod,
+        callback(&_taskSupervisor, &bike_computer::TaskSupervisor::check));
+
    
     #if !MBED_TEST_MODE
-    _memoryLogger.getAndPrintStatistics();
-    _memoryLogger.printDiffs();
+    // the statistics are not needed for the first frame, the steady state is
+    // entered once the jobs deferred before (update client) are done
+    bike_computer::StartupTimeline& startupTimeline =
+        bike_computer::StartupTimeline::getInstance();
+    startupTimeline.defer(
+        "MemoryStatistics",
+        callback(&_memoryLogger, &advembsof::MemoryLogger::getAndPrintStatistics));
+    startupTimeline.defer(
+        "HeapSteadyState",
+        callback(&heapMonitor, &bike_computer::HeapMonitor::enterSteadyState));
     #endif
 
     _eventQueuePeriodic.dispatch_forever();
@@ -118,69 +262,237 @@ void BikeSystem::start() {
 
 }
 
-void BikeSystem::stop() { 
-    core_util_atomic_store_bool(&_stopFlag, true); 
+void BikeSystem::stop() {
+    // the threads of this system are destroyed and the next system allocates its
+    // own ones
+    bike_computer::HeapMonitor::getInstance().leaveSteadyState();
+    core_util_atomic_store_bool(&_stopFlag, true);
+    // no periodic task and no heartbeat check runs once stopped
+    _timerWheel.stop();
+    if (_supervisorCheckId != 0) {
+        _eventQueueISR.cancel(_supervisorCheckId);
+    }
+    _eventQueueISR.break_dispatch();
+    // not started or already terminated
+    if (_ThreadISR.get_id() != nullptr) {
+        _ThreadISR.join();
+    }
     _eventQueuePeriodic.break_dispatch();
+    // the frame being drawn is shown and the requested odometer write is done
+    _displayRenderer.stop();
+    _odometer.stop();
+    // the next instance continues with the exact distance
+    saveRideState();
 }
 
 #if defined(MBED_TEST_MODE)
 const advembsof::TaskLogger& BikeSystem::getTaskLogger() { return _taskLogger; }
+
+std::chrono::microseconds BikeSystem::getInitDuration() const { return _initDuration; }
+
+const bike_computer::InputRecorder& BikeSystem::getInputRecorder() const {
+    return _inputRecorder;
+}
+
+bike_computer::InputReplayer& BikeSystem::getInputReplayer() { return _inputReplayer; }
 #endif  // defined(MBED_TEST_MODE)
 
 void BikeSystem::init() {
     // start the timer
     _timer.start();
+    // the inputs are recorded from now on
+    _inputRecorder.start();
+
+    // the display, the sensor and the storage are independent, they are
+    // initialized concurrently. A restart of the bike system (warm restart) keeps
+    // the display and the sensor initialized, the renderer redraws all fields on
+    // its first snapshot.
+    const bool warmRestart = _devicesInitialized;
+    bike_computer::InitGraph initGraph;
+    if (!warmRestart) {
+        initGraph.addJob("Display", callback(this, &BikeSystem::initDisplay));
+        initGraph.addJob("Sensor", callback(this, &BikeSystem::initSensor));
+    }
+    const bike_computer::InitGraph::JobId storageJobId =
+        initGraph.addJob("Storage", callback(this, &BikeSystem::initStorage));
+    // after the drivetrain profile, which limits the gear
+    initGraph.addJob("RideState",
+                     callback(this, &BikeSystem::restoreRideState),
+                     bike_computer::InitGraph::dependsOn(storageJobId));
+    initGraph.run();
+    _devicesInitialized = true;
+    _displayRenderer.start();
+
+    // enable/disable task logging
+    _taskLogger.enable(true);
+
+    // traces are formatted and printed by a low priority thread
+    {
+        bike_computer::HeapTagScope heapTagScope(bike_computer::HeapTag::Logging);
+        bike_computer::BinaryTrace::getInstance().start();
+    }
+
+    _initDuration = _timer.elapsed_time();
+    tr_info("%s start, initialized in %" PRIu32 " us",
+            warmRestart ? "Warm" : "Cold",
+            static_cast<uint32_t>(_initDuration.count()));
+}
 
-    // initialize the lcd display
+void BikeSystem::initDisplay() {
+    // heap used by the concurrent jobs in the meantime is also attributed to the
+    // display (the sensor and the storage are constructed with the bike system)
+    bike_computer::HeapTagScope heapTagScope(bike_computer::HeapTag::Display);
     disco::ReturnCode rc = _displayDevice.init();
     if (rc != disco::ReturnCode::Ok) {
         tr_error("Failed to initialized the lcd display: %d", static_cast<int>(rc));
+    } else if (!GlyphAtlas::getInstance().build()) {
+        // the values are then drawn by the lcd utilities, with the same layout
+        tr_error("Cannot build the glyph atlas");
     }
+}
 
-    // initialize the sensor device
+void BikeSystem::initSensor() {
     bool present = _sensorDevice.init();
     if (!present) {
         tr_error("Sensor not present or initialization failed");
     }
-    
-    // enable/disable task logging
-    _taskLogger.enable(true);
+}
+
+void BikeSystem::initStorage() {
+    // load the drivetrain profile and the persistent counters
+    bike_computer::KVReturnCode kvrc = _kvStore.init();
+    if (kvrc != bike_computer::KVReturnCode::Ok) {
+        tr_error("Cannot initialize the key-value store: %d", static_cast<int>(kvrc));
+    } else {
+        loadDrivetrainProfile();
+        _odometer.start();
+    }
+}
+
+void BikeSystem::restoreRideState() {
+    bike_computer::RideState rideState;
+    if (!bike_computer::RetainedRideState::getInstance().load(rideState)) {
+        return;
+    }
+    // the restored gear and rotation time are reported as events, they are
+    // handled once the periodic event queue is dispatched
+    _speedometer.restoreDistance(rideState.distance);
+    _odometer.restoreTraveledDistance(rideState.distance);
+    _gearDevice.restoreGear(rideState.gear);
+    _pedalDevice.restoreRotationTime(
+        std::chrono::milliseconds(rideState.pedalRotationTime));
+    tr_info("Ride state restored: %f km, gear %d", rideState.distance, rideState.gear);
+}
+
+void BikeSystem::saveRideState() {
+    bike_computer::RideState rideState = {};
+    rideState.distance                 = _speedometer.getDistance();
+    rideState.pedalRotationTime =
+        static_cast<uint32_t>(_pedalDevice.getCurrentRotationTime().count());
+    rideState.gear = _gearDevice.getCurrentGear();
+    bike_computer::RetainedRideState::getInstance().save(rideState);
 }
 
 
 void BikeSystem::onGearEvent(uint8_t gear, uint8_t gearSize){
+    _eventQueuePeriodicMonitor.recordDispatch();
+    _modeManager.onActivity();
     _currentGear = gear;
+    // gearSize is the cog size of the gear in the drivetrain profile
     _speedometer.setGearSize(gearSize);
-    
+    _tripStatistics.onGearChanged(_timer.elapsed_time(), _speedometer.getCurrentSpeed());
+    bike_computer::DataBus& dataBus = bike_computer::DataBus::getInstance();
+    dataBus.getGearTopic().publish({gear, gearSize});
+    dataBus.getSpeedTopic().publish(_speedometer.getCurrentSpeed());
+    saveRideState();
+    if (_periodicTraceChannel != nullptr) {
+        _periodicTraceChannel->write(
+            bike_computer::TraceFormat::GearChanged, gear, gearSize);
+    }
 }
 
 void BikeSystem::onPedalEvent(const std::chrono::milliseconds& rotationTime){
+    _eventQueuePeriodicMonitor.recordDispatch();
+    _modeManager.onActivity();
     _speedometer.setCurrentRotationTime(rotationTime);
+    _tripStatistics.onPedalRotationChanged(
+        _timer.elapsed_time(), _speedometer.getCurrentSpeed(), rotationTime);
+    bike_computer::DataBus::getInstance().getSpeedTopic().publish(
+        _speedometer.getCurrentSpeed());
+    if (_periodicTraceChannel != nullptr) {
+        _periodicTraceChannel->write(bike_computer::TraceFormat::PedalRotationChanged,
+                                     static_cast<uint32_t>(rotationTime.count()));
+    }
+    saveRideState();
 }
 
 
 void BikeSystem::temperatureTask() {
     auto taskStartTime = _timer.elapsed_time();
 
-    // no need to protect access to data members (single threaded)
-    _currentTemperature = _sensorDevice.readTemperature();
+    // the periodic thread handles other events during the conversion, the
+    // temperature is published once it is read (onTemperatureRead). A read still
+    // running is not restarted, it is counted as an overrun.
+    _temperatureReadTask.start(
+        callback(&_sensorDevice, &bike_computer::SensorDevice::readTemperatureStep),
+        callback(this, &BikeSystem::onTemperatureRead));
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kTemperatureTaskIndex, taskStartTime);
+    _taskSupervisor.heartbeat(_temperatureHeartbeatId);
+}
+
+void BikeSystem::onTemperatureRead() {
+    // no need to protect access to data members (single threaded), a failed read
+    // keeps the last published temperature
+    if (!_sensorDevice.getLastTemperature(_currentTemperature)) {
+        return;
+    }
+    bike_computer::DataBus::getInstance().getTemperatureTopic().publish(
+        _currentTemperature);
 }
 
 void BikeSystem::onReset() {
     _resetTime = _timer.elapsed_time();
-    _eventQueueISR.call(callback(this, &BikeSystem::resetTask));
+    _inputRecorder.record(bike_computer::InputEvent::ResetButton);
+    int id = _eventQueueISR.call(callback(this, &BikeSystem::resetTask));
+    _eventQueueISRMonitor.recordPost(id != 0);
+}
+
+void BikeSystem::onTripReset() {
+    _inputRecorder.record(bike_computer::InputEvent::TripResetButton);
+    int id = _eventQueueISR.call(callback(this, &BikeSystem::tripResetTask));
+    _eventQueueISRMonitor.recordPost(id != 0);
 }
 
 void BikeSystem::resetTask() {
+    _eventQueueISRMonitor.recordDispatch();
+    _modeManager.onActivity();
+    const std::chrono::microseconds responseTime = _timer.elapsed_time() - _resetTime;
+    _resetLatencyStats.record(responseTime);
 
     //disable logging in test mode
-      #if !MBED_TEST_MODE 
-      tr_info("Reset task: response time is %" PRIu64 " usecs",
-                (_timer.elapsed_time() - _resetTime).count());
-      #endif
+    #if !MBED_TEST_MODE
+    // only the raw response time is stored, formatting is deferred
+    if (_isrTraceChannel != nullptr) {
+        _isrTraceChannel->write(bike_computer::TraceFormat::ResetResponseTime,
+                                static_cast<uint32_t>(responseTime.count()));
+    }
+    #endif
     _speedometer.reset();
+    saveRideState();
+    _tripStatistics.reset(_timer.elapsed_time());
+    // the graph is emptied on the next display task
+    _speedHistory.reset();
+    _odometer.resetTrip(bike_computer::TripCounter::A);
+    bike_computer::DataBus::getInstance().getDistanceTopic().publish(
+        _speedometer.getDistance());
+}
+
+void BikeSystem::tripResetTask() {
+    _eventQueueISRMonitor.recordDispatch();
+    _modeManager.onActivity();
+    // trip A, the ride and the speedometer are kept
+    _odometer.resetTrip(bike_computer::TripCounter::B);
 }
 
 void BikeSystem::displayTask() {
@@ -189,14 +501,133 @@ void BikeSystem::displayTask() {
     _traveledDistance = _speedometer.getDistance();
 
     auto taskStartTime = _timer.elapsed_time();
-    _displayDevice.displayGear(_currentGear);
-    _displayDevice.displaySpeed(_currentSpeed);
-    _displayDevice.displayDistance(_traveledDistance);
-    _displayDevice.displayTemperature(_currentTemperature);
+    _speedHistory.push(_currentSpeed);
+    bike_computer::DataBus::getInstance().getDistanceTopic().publish(_traveledDistance);
+    _odometer.update(_traveledDistance, _currentSpeed, taskStartTime);
+    // drawing is done by the render thread, only publish the values here
+    const DisplaySnapshot snapshot = {
+        _currentGear, _currentSpeed, _traveledDistance, _currentTemperature};
+    _displayRenderer.publish(snapshot);
+    // the distance lost on a reset is at most one display period
+    saveRideState();
 
-    
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kDisplayTask1Index, taskStartTime);
+    _taskSupervisor.heartbeat(_displayHeartbeatId);
+}
+
+void BikeSystem::heartbeatTask() { _taskSupervisor.heartbeat(_periodicHeartbeatId); }
+
+void BikeSystem::printStatistics() {
+    bike_computer::printBikeSystemStats(_cpuLogger, _taskLogger, _resetLatencyStats);
+    _inputRecorder.printLog();
+}
+
+bool BikeSystem::replayInputs(const uint32_t* log, uint16_t nbrOfRecords) {
+    // the times of the log are measured from the start of the recorder, at the
+    // init of the recording system: the replay is anchored to the start of the
+    // recorder of this system
+    if (!_inputRecorder.isRecording()) {
+        return false;
+    }
+    return _inputReplayer.start(log, nbrOfRecords, _inputRecorder.getElapsedTime());
+}
+
+void BikeSystem::injectInput(bike_computer::InputEvent inputEvent) {
+    switch (inputEvent) {
+        case bike_computer::InputEvent::JoystickUp:
+        case bike_computer::InputEvent::JoystickDown:
+            _gearDevice.injectInput(inputEvent);
+            break;
+        case bike_computer::InputEvent::JoystickLeft:
+        case bike_computer::InputEvent::JoystickRight:
+            _pedalDevice.injectInput(inputEvent);
+            break;
+        case bike_computer::InputEvent::ResetButton:
+            onReset();
+            break;
+        case bike_computer::InputEvent::TripResetButton:
+            onTripReset();
+            break;
+        default:
+            break;
+    }
+}
+
+void BikeSystem::printEventQueueStats() {
+    _eventQueuePeriodicMonitor.printStats();
+    _eventQueueISRMonitor.printStats();
+}
+
+bool BikeSystem::setDrivetrainProfile(const bike_computer::DrivetrainProfile& profile) {
+    if (!bike_computer::Drivetrain::isValid(profile)) {
+        return false;
+    }
+    bike_computer::KVReturnCode rc =
+        _kvStore.set(bike_computer::kDrivetrainProfileKey, &profile, sizeof(profile));
+    if (rc != bike_computer::KVReturnCode::Ok) {
+        tr_error("Cannot store the drivetrain profile: %d", static_cast<int>(rc));
+        return false;
+    }
+    // the speedometer and the gear device are only modified by the periodic thread
+    int id =
+        _eventQueuePeriodic.call(this, &BikeSystem::onDrivetrainProfileEvent, profile);
+    _eventQueuePeriodicMonitor.recordPost(id != 0);
+    return id != 0;
+}
+
+void BikeSystem::onDrivetrainProfileEvent(bike_computer::DrivetrainProfile profile) {
+    _eventQueuePeriodicMonitor.recordDispatch();
+    applyDrivetrainProfile(profile);
+}
+
+void BikeSystem::loadDrivetrainProfile() {
+    bike_computer::DrivetrainProfile profile;
+    uint32_t size = 0;
+    bike_computer::KVReturnCode rc = _kvStore.get(
+        bike_computer::kDrivetrainProfileKey, &profile, sizeof(profile), size);
+    if (rc == bike_computer::KVReturnCode::Ok && size == sizeof(profile)) {
+        applyDrivetrainProfile(profile);
+    } else {
+        tr_info("Using the default drivetrain profile");
+    }
+}
+
+void BikeSystem::applyDrivetrainProfile(bike_computer::DrivetrainProfile profile) {
+    if (!_speedometer.setDrivetrainProfile(profile)) {
+        return;
+    }
+    _gearDevice.setCassette(profile);
+    _currentGear          = _gearDevice.getCurrentGear();
+    const uint8_t cogSize = _gearDevice.getCurrentGearSize();
+    _speedometer.setGearSize(cogSize);
+    bike_computer::DataBus::getInstance().getGearTopic().publish({_currentGear, cogSize});
+    tr_info("Drivetrain: %d chainring(s), %d gears",
+            profile.nbrOfChainrings,
+            profile.nbrOfCogs);
+}
+
+void BikeSystem::printTripStatistics() {
+    bike_computer::TripSnapshot snapshot;
+    _tripStatistics.getSnapshot(_timer.elapsed_time(), snapshot);
+    tr_info("Trip: average %f km/h, max %f km/h, moving %" PRIu32 " s",
+            snapshot.averageSpeed,
+            snapshot.maxSpeed,
+            static_cast<uint32_t>(snapshot.movingTime.count() / 1000));
+    tr_info("Odometer: %" PRIu32 " m, trip A: %" PRIu32 " m, trip B: %" PRIu32 " m",
+            _odometer.getOdometer(),
+            _odometer.getTrip(bike_computer::TripCounter::A),
+            _odometer.getTrip(bike_computer::TripCounter::B));
+    for (uint8_t zone = 0; zone < bike_computer::kNbrOfSpeedZones; zone++) {
+        tr_info("  speed zone %d: %" PRIu32 " s",
+                zone,
+                static_cast<uint32_t>(snapshot.timeInSpeedZone[zone].count() / 1000));
+    }
+    for (uint8_t zone = 0; zone < bike_computer::kNbrOfCadenceZones; zone++) {
+        tr_info("  cadence zone %d: %" PRIu32 " s",
+                zone,
+                static_cast<uint32_t>(snapshot.timeInCadenceZone[zone].count() / 1000));
+    }
 }
 
 #if defined(MBED_TEST_MODE)
@@ -26,6 +26,7 @@
 
 // from advembsof
 #include "EventQueue.h"
+#include "FlashIAPBlockDevice.h"
 #include "Timer.h"
 #include "cpu_logger.hpp"
 #include "display_device.hpp"
@@ -33,10 +34,32 @@
 #include "memory_logger.hpp"
 
 // from common
+#include "binary_trace.hpp"
+#include "data_bus.hpp"
+#include "drivetrain.hpp"
+#include "flash_kv_store.hpp"
+#include "heap_monitor.hpp"
+#include "init_graph.hpp"
+#include "input_recorder.hpp"
+#include "latency_stats.hpp"
+#include "mode_manager.hpp"
+#include "odometer.hpp"
+#include "overload_manager.hpp"
+#include "resumable_task.hpp"
 #include "sensor_device.hpp"
+#include "retained_ride_state.hpp"
+#include "speed_history.hpp"
 #include "speedometer.hpp"
+#include "stack_profiler.hpp"
+#include "startup_timeline.hpp"
+#include "task_supervisor.hpp"
+#include "thread_cpu_logger.hpp"
+#include "timer_wheel.hpp"
+#include "trip_statistics.hpp"
 
 // local
+#include "crank_sensor_device.hpp"
+#include "display_renderer.hpp"
 #include "gear_device.hpp"
 #include "pedal_device.hpp"
 #include "reset_device.hpp"
@@ -59,33 +82,76 @@ class BikeSystem {
     void stop();
 
     void onReset();
+    // long press of the reset button, resets trip B
+    void onTripReset();
+
+    // cpu usage, task periods and computation times, reset response time and
+    // recorded inputs
+    void printStatistics();
+
+    // inject the inputs of a log printed by printStatistics() with the recorded
+    // timing from the start of the system (the replayed inputs are recorded
+    // again), returns false if a replay is running, if the system is not started
+    // or if its input log is full
+    bool replayInputs(const uint32_t* log, uint16_t nbrOfRecords);
+
+    // store the drivetrain profile in the key-value store (loaded from the next
+    // start on) and apply it, returns false if the profile is not valid or cannot
+    // be stored
+    bool setDrivetrainProfile(const bike_computer::DrivetrainProfile& profile);
 
 #if defined(MBED_TEST_MODE)
     const advembsof::TaskLogger& getTaskLogger();
     uint8_t getCurrentGear();
     GearDevice& getGearDevice();
     bike_computer::Speedometer& getSpeedometer();
+    std::chrono::microseconds getInitDuration() const;
+    const bike_computer::InputRecorder& getInputRecorder() const;
+    bike_computer::InputReplayer& getInputReplayer();
 #endif  // defined(MBED_TEST_MODE)
 
    private:
     // private methods
     void init();
+    // init jobs
+    void initDisplay();
+    void initSensor();
+    void initStorage();
+    void restoreRideState();
+    void saveRideState();
     void temperatureTask();
+    void onTemperatureRead();
     void resetTask();
+    void tripResetTask();
     void displayTask();
+    void heartbeatTask();
 
     
     void onPedalEvent(const std::chrono::milliseconds& rotationTime);
     void onGearEvent(uint8_t gear, uint8_t gearSize);
+    void injectInput(bike_computer::InputEvent inputEvent);
+    void printEventQueueStats();
+    void printTripStatistics();
+    void loadDrivetrainProfile();
+    void applyDrivetrainProfile(bike_computer::DrivetrainProfile profile);
+    void onDrivetrainProfileEvent(bike_computer::DrivetrainProfile profile);
     
     EventQueue _eventQueuePeriodic; //used for periodic and datadriven events
     EventQueue _eventQueueISR; //used for ISRs
+    // used for reporting the occupancy of the event queues
+    bike_computer::EventQueueMonitor _eventQueuePeriodicMonitor;
+    bike_computer::EventQueueMonitor _eventQueueISRMonitor;
 
     Thread _ThreadISR;
+    // periodic heartbeat check on the ISR queue, cancelled in stop()
+    int _supervisorCheckId = 0;
     // stop flag, used for stopping the super-loop (set in stop())
     bool _stopFlag = false;
     // timer instance used for loggint task time and used by ResetDevice
     Timer _timer;
+    // records the inputs received by the devices below, constructed first
+    bike_computer::InputRecorder _inputRecorder;
+    bike_computer::InputReplayer _inputReplayer;
     // data member that represents the device for manipulating the gear
     GearDevice _gearDevice;
     uint8_t _currentGear     = bike_computer::kMinGear;
@@ -93,16 +159,33 @@ class BikeSystem {
     // data member that represents the device for manipulating the pedal rotation
     // speed/time
     PedalDevice _pedalDevice;
+#if defined(MBED_CONF_APP_CRANK_SENSOR_PIN)
+    // measured pedal rotation time, reported as the pedal device does
+    CrankSensorDevice _crankSensorDevice;
+#endif  // defined(MBED_CONF_APP_CRANK_SENSOR_PIN)
     float _currentSpeed     = 0.0f;
     float _traveledDistance = 0.0f;
     // data member that represents the device used for resetting
     ResetDevice _resetDevice;
     // data member that represents the device display
     advembsof::DisplayDevice _displayDevice;
+    // speed samples shown as a rolling graph
+    bike_computer::SpeedHistory _speedHistory;
+    // renders the display on its own thread
+    DisplayRenderer _displayRenderer;
     // data member that represents the device for counting wheel rotations
     bike_computer::Speedometer _speedometer;
+    // fed with the same events as the speedometer
+    bike_computer::TripStatistics _tripStatistics;
+    // flash region holding the persistent counters and the drivetrain profile
+    FlashIAPBlockDevice _kvBlockDevice;
+    bike_computer::FlashKVStore _kvStore;
+    // lifetime and trip distances
+    bike_computer::Odometer _odometer;
     // data member that represents the sensor device
     bike_computer::SensorDevice _sensorDevice;
+    // runs the steps of a temperature read on the periodic thread
+    bike_computer::ResumableTask _temperatureReadTask;
     float _currentTemperature = 0.0f;
 
     // used for logging task info
@@ -114,9 +197,43 @@ class BikeSystem {
     //Adding a memory logger instance
     advembsof::MemoryLogger _memoryLogger;
 
+    // runs the periodic tasks on the periodic event queue
+    bike_computer::TimerWheel _timerWheel;
+    // selects the task periods from the operating mode
+    bike_computer::ModeManager _modeManager;
+    // degrades the periodic tasks when they run late
+    bike_computer::OverloadManager _overloadManager;
+#if defined(MBED_TEST_MODE) || (MBED_CONF_APP_BENCHMARK_NBR_OF_PRESSES > 0)
+    // the hardware watchdog cannot be stopped, it is simulated when the system
+    // is stopped by a test or by the benchmark
+    bike_computer::SimulatedWatchdog _simulatedWatchdog;
+#endif  // defined(MBED_TEST_MODE) || (MBED_CONF_APP_BENCHMARK_NBR_OF_PRESSES > 0)
+    // kicks the watchdog while the supervised tasks are alive
+    bike_computer::TaskSupervisor _taskSupervisor;
+    bike_computer::TaskSupervisor::HeartbeatId _temperatureHeartbeatId =
+        bike_computer::TaskSupervisor::kInvalidHeartbeatId;
+    bike_computer::TaskSupervisor::HeartbeatId _displayHeartbeatId =
+        bike_computer::TaskSupervisor::kInvalidHeartbeatId;
+    bike_computer::TaskSupervisor::HeartbeatId _periodicHeartbeatId =
+        bike_computer::TaskSupervisor::kInvalidHeartbeatId;
+
+    // used for reporting stack peaks and recommended stack sizes
+    bike_computer::StackProfiler _stackProfiler;
+
+    // deferred trace channels, one per thread
+    bike_computer::TraceChannel* _periodicTraceChannel = nullptr;
+    bike_computer::TraceChannel* _isrTraceChannel      = nullptr;
+
+    // the display and the sensor are initialized once per boot, they are not
+    // initialized again when the bike system restarts
+    static bool _devicesInitialized;
+    std::chrono::microseconds _initDuration = std::chrono::microseconds::zero();
+
     // used to register the occurence of the reset
     std::chrono::microseconds _resetTime = std::chrono::microseconds::zero();
     volatile bool _resetFlag             = false;
+    // measured in resetTask
+    bike_computer::LatencyStats _resetLatencyStats;
 };
 
 }  // namespace static_scheduling_with_event
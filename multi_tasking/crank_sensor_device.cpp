@@ -0,0 +1,110 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file crank_sensor_device.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Crank sensor implementation (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "crank_sensor_device.hpp"
+
+#include <chrono>
+
+#include "constants.hpp"
+#include "us_ticker_api.h"
+
+namespace multi_tasking {
+
+// a reed contact bounces for less than 1 ms, the crank never turns faster than
+// kMinPedalRotationTime
+static constexpr std::chrono::microseconds kDebounceTime = 5ms;
+// no pulse for twice the slowest rotation time means that the crank stopped,
+// checked twice per slowest rotation time
+static constexpr std::chrono::microseconds kStopTimeout =
+    2 * bike_computer::kMaxPedalRotationTime;
+static constexpr std::chrono::milliseconds kStopCheckPeriod =
+    bike_computer::kMaxPedalRotationTime / 2;
+
+CrankSensorDevice::CrankSensorDevice(
+    PinName pin,
+    EventQueue& eventQueue,
+    mbed::Callback<void(const std::chrono::milliseconds&)> cb,
+    bike_computer::EventQueueMonitor* eventQueueMonitor)
+    : _input(pin, PullUp),
+      _pulseFilter(kDebounceTime, kStopTimeout),
+      _eventQueue(eventQueue),
+      _cb(cb),
+      _eventQueueMonitor(eventQueueMonitor) {
+    // the magnet closes the contact to the ground
+    _input.fall(callback(this, &CrankSensorDevice::onPulse));
+    _stopCheckId = _eventQueue.call_every(
+        kStopCheckPeriod, callback(this, &CrankSensorDevice::onStopCheck));
+}
+
+CrankSensorDevice::~CrankSensorDevice() {
+    _input.fall(nullptr);
+    if (_stopCheckId != 0) {
+        _eventQueue.cancel(_stopCheckId);
+    }
+}
+
+const bike_computer::PulseFilter& CrankSensorDevice::getPulseFilter() const {
+    return _pulseFilter;
+}
+
+void CrankSensorDevice::onPulse() {
+    // constant time: timestamp, filter, and post only if no event is pending
+    if (_pulseFilter.onEdge(us_ticker_read())) {
+        postRotation();
+    }
+}
+
+void CrankSensorDevice::postRotation() {
+    // called in ISR context and from the event queue, at most one event is pending
+    if (core_util_atomic_exchange_bool(&_eventPending, true)) {
+        return;
+    }
+    int id = _eventQueue.call(callback(this, &CrankSensorDevice::onRotation));
+    if (id == 0) {
+        core_util_atomic_store_bool(&_eventPending, false);
+    }
+    if (_eventQueueMonitor != nullptr) {
+        _eventQueueMonitor->recordPost(id != 0);
+    }
+}
+
+void CrankSensorDevice::onRotation() {
+    core_util_atomic_store_bool(&_eventPending, false);
+
+    // the last period is zero once the crank stopped, which publishes a zero
+    // cadence
+    const auto rotationTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        _pulseFilter.getLastPeriod());
+    _cb(rotationTime);
+}
+
+void CrankSensorDevice::onStopCheck() {
+    // reported as a rotation event, like the pulses (a pending event reports the
+    // zero period)
+    if (_pulseFilter.checkStopped(us_ticker_read())) {
+        postRotation();
+    }
+}
+
+}  // namespace multi_tasking
@@ -0,0 +1,73 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file crank_sensor_device.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Crank (reed/Hall) sensor, pulses timestamped in the interrupt handler
+ *        and measured pedal rotation times posted to an event queue
+ *        (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "InterruptIn.h"
+#include "heap_monitor.hpp"
+#include "mbed.h"
+#include "pulse_filter.hpp"
+
+namespace multi_tasking {
+
+class CrankSensorDevice {
+   public:
+    CrankSensorDevice(PinName pin,
+                      EventQueue& eventQueue,  // NOLINT(runtime/references)
+                      mbed::Callback<void(const std::chrono::milliseconds&)> cb,
+                      bike_computer::EventQueueMonitor* eventQueueMonitor = nullptr);
+
+    // make the class non copyable
+    CrankSensorDevice(CrankSensorDevice&)            = delete;
+    CrankSensorDevice& operator=(CrankSensorDevice&) = delete;
+
+    ~CrankSensorDevice();
+
+    const bike_computer::PulseFilter& getPulseFilter() const;
+
+   private:
+    void onPulse();
+    void postRotation();
+    void onRotation();
+    void onStopCheck();
+
+    InterruptIn _input;
+    bike_computer::PulseFilter _pulseFilter;
+
+    // Eventqueue
+    EventQueue& _eventQueue;
+    // Callbacks
+    mbed::Callback<void(const std::chrono::milliseconds&)> _cb;
+    // used for reporting posts to the event queue (optional)
+    bike_computer::EventQueueMonitor* _eventQueueMonitor;
+
+    // at most one event is pending, it reports the latest period
+    volatile bool _eventPending = false;
+    // periodic check publishing a zero cadence when the crank stopped
+    int _stopCheckId = 0;
+};
+
+}  // namespace multi_tasking
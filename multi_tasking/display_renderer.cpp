@@ -0,0 +1,256 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file display_renderer.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Display renderer implementation (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "display_renderer.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "glyph_atlas.hpp"
+#include "mbed_trace.h"
+#include "startup_timeline.hpp"
+
+// from disco_h747i (STM32 BSP and lcd utilities)
+#include "stm32_lcd.h"
+#include "stm32h747i_discovery_lcd.h"
+
+#if MBED_CONF_MBED_TRACE_ENABLE
+#define TRACE_GROUP "DisplayRenderer"
+#endif  // MBED_CONF_MBED_TRACE_ENABLE
+
+namespace multi_tasking {
+
+// layer used by the display device
+static constexpr uint32_t kLcdLayer = 0;
+// the copy of a 800x480 ARGB8888 frame takes a few ms
+static constexpr uint32_t kFrameCopyTimeout = 100;  // ms
+// the lcd controller reloads its registers once per frame (60 Hz)
+static constexpr std::chrono::milliseconds kReloadPollPeriod = 2ms;
+static constexpr uint8_t kMaxReloadPolls                     = 50;
+
+// layout of the fields (with or without glyph atlas), one line per field
+static constexpr uint32_t kFieldXPos     = 20;
+static constexpr uint8_t kFieldFirstLine = 2;
+static constexpr uint8_t kLabelLength    = 10;
+static constexpr uint8_t kValueLength    = 12;
+static const char* const kFieldLabels[]  = {"Gear:", "Speed:", "Distance:", "Temp.:"};
+static const char* const kFieldUnits[]   = {"", " km/h", " km", " C"};
+static_assert(kValueLength <= GlyphAtlas::kMaxTextLength,
+              "A value is drawn at once with the glyph atlas");
+
+DisplayRenderer::DisplayRenderer(const bike_computer::SpeedHistory& speedHistory)
+    : _speedSparkline(speedHistory),
+      _thread(osPriorityLow,
+              MBED_CONF_APP_RENDER_THREAD_STACK_SIZE,
+              nullptr,
+              "RenderThread") {}
+
+void DisplayRenderer::start() {
+    // the frame buffer of the display device is at the start of the SDRAM, the
+    // back buffer follows it. The shown buffer is kept by a warm restart.
+    const LTDC_LayerCfgTypeDef& layerCfg = hlcd_ltdc.LayerCfg[kLcdLayer];
+    _frameBuffers[0]                     = LCD_LAYER_0_ADDRESS;
+    _frameBuffers[1]                     = LCD_LAYER_0_ADDRESS +
+                       layerCfg.ImageWidth * layerCfg.ImageHeight * sizeof(uint32_t);
+    _backBuffer = layerCfg.FBStartAdress == _frameBuffers[1] ? 0 : 1;
+    // the frames are copied as ARGB8888
+    _isDoubleBuffered = layerCfg.PixelFormat == LTDC_PIXEL_FORMAT_ARGB8888;
+    if (!_isDoubleBuffered) {
+        tr_warn("Unexpected pixel format %" PRIu32 ", no double buffering",
+                layerCfg.PixelFormat);
+    }
+    _thread.start(callback(this, &DisplayRenderer::render));
+}
+
+void DisplayRenderer::stop() {
+    if (_thread.get_id() == nullptr) {
+        return;
+    }
+    _eventFlags.set(kStopFlag);
+    _thread.join();
+}
+
+void DisplayRenderer::publish(const DisplaySnapshot& snapshot) {
+    core_util_critical_section_enter();
+    if (_hasNewSnapshot) {
+        _droppedCount++;
+    }
+    _snapshot       = snapshot;
+    _hasNewSnapshot = true;
+    core_util_critical_section_exit();
+
+    _eventFlags.set(kNewSnapshotFlag);
+}
+
+uint32_t DisplayRenderer::getDroppedCount() const { return _droppedCount; }
+
+int32_t DisplayRenderer::quantize(float value) {
+    static constexpr float kResolution = 100.0f;
+    return static_cast<int32_t>(lroundf(value * kResolution));
+}
+
+void DisplayRenderer::render() {
+    while (true) {
+        const uint32_t flags = _eventFlags.wait_any(kNewSnapshotFlag | kStopFlag);
+        if ((flags & kStopFlag) != 0) {
+            return;
+        }
+
+        DisplaySnapshot snapshot;
+        core_util_critical_section_enter();
+        snapshot        = _snapshot;
+        _hasNewSnapshot = false;
+        core_util_critical_section_exit();
+
+        // drawing only happens on this thread, the control path never waits
+        // for the lcd, and only the fields that changed on screen are redrawn
+        const int32_t values[NbrOfFields] = {snapshot.gear,
+                                             quantize(snapshot.speed),
+                                             quantize(snapshot.distance),
+                                             quantize(snapshot.temperature)};
+        const bool isFrameInBackBuffer = _isDoubleBuffered && beginFrame();
+        const bool useGlyphAtlas       = GlyphAtlas::getInstance().isBuilt();
+        if (!_hasRenderedValues) {
+            drawLabels();
+        }
+        for (uint8_t field = 0; field < NbrOfFields; field++) {
+            if (_hasRenderedValues && values[field] == _renderedValues[field]) {
+                continue;
+            }
+            drawField(static_cast<Field>(field), values, useGlyphAtlas);
+        }
+        for (uint8_t field = 0; field < NbrOfFields; field++) {
+            _renderedValues[field] = values[field];
+        }
+
+        // only the samples pushed since the previous snapshot are drawn
+        _speedSparkline.render();
+
+        if (isFrameInBackBuffer) {
+            endFrame();
+        }
+        if (!_hasRenderedValues) {
+            bike_computer::StartupTimeline::getInstance().markFirstFrame();
+        }
+        _hasRenderedValues = true;
+    }
+}
+
+bool DisplayRenderer::beginFrame() {
+    const uint32_t frontBuffer           = _frameBuffers[1 - _backBuffer];
+    const uint32_t backBuffer            = _frameBuffers[_backBuffer];
+    const LTDC_LayerCfgTypeDef& layerCfg = hlcd_ltdc.LayerCfg[kLcdLayer];
+
+    // memory to memory copy of the shown frame, the DMA2D handle of the BSP is
+    // configured again by each BSP fill (only used by this thread)
+    hlcd_dma2d.Instance                   = DMA2D;
+    hlcd_dma2d.Init.Mode                  = DMA2D_M2M;
+    hlcd_dma2d.Init.ColorMode             = DMA2D_OUTPUT_ARGB8888;
+    hlcd_dma2d.Init.OutputOffset          = 0;
+    hlcd_dma2d.LayerCfg[1].InputColorMode = DMA2D_INPUT_ARGB8888;
+    hlcd_dma2d.LayerCfg[1].InputOffset    = 0;
+    hlcd_dma2d.LayerCfg[1].AlphaMode      = DMA2D_NO_MODIF_ALPHA;
+    hlcd_dma2d.LayerCfg[1].InputAlpha     = 0xFF;
+    if (HAL_DMA2D_Init(&hlcd_dma2d) != HAL_OK ||
+        HAL_DMA2D_ConfigLayer(&hlcd_dma2d, 1) != HAL_OK ||
+        HAL_DMA2D_Start(&hlcd_dma2d,
+                        frontBuffer,
+                        backBuffer,
+                        layerCfg.ImageWidth,
+                        layerCfg.ImageHeight) != HAL_OK ||
+        HAL_DMA2D_PollForTransfer(&hlcd_dma2d, kFrameCopyTimeout) != HAL_OK) {
+        tr_error("Cannot copy the frame to the back buffer");
+        return false;
+    }
+
+    // the drawing functions write to the address of the layer configuration, the
+    // lcd controller keeps reading the front buffer until its registers are
+    // reloaded
+    return HAL_LTDC_SetAddress_NoReload(&hlcd_ltdc, backBuffer, kLcdLayer) == HAL_OK;
+}
+
+void DisplayRenderer::endFrame() {
+    // the new address is applied during the next vertical blanking, the frame is
+    // never shown partially drawn
+    hlcd_ltdc.Instance->SRCR = LTDC_SRCR_VBR;
+    uint8_t nbrOfPolls       = 0;
+    while ((hlcd_ltdc.Instance->SRCR & LTDC_SRCR_VBR) != 0 &&
+           nbrOfPolls < kMaxReloadPolls) {
+        ThisThread::sleep_for(kReloadPollPeriod);
+        nbrOfPolls++;
+    }
+    if (nbrOfPolls == kMaxReloadPolls) {
+        tr_error("The lcd controller did not reload its registers");
+    }
+    _backBuffer = 1 - _backBuffer;
+}
+
+void DisplayRenderer::drawLabels() {
+    // the glyphs of the atlas are rendered with the lcd font
+    const uint16_t lineHeight = UTIL_LCD_GetFont()->Height;
+    for (uint8_t field = 0; field < NbrOfFields; field++) {
+        // the text is not modified by the lcd utilities
+        uint8_t* label = const_cast<uint8_t*>(
+            reinterpret_cast<const uint8_t*>(kFieldLabels[field]));
+        UTIL_LCD_DisplayStringAt(
+            kFieldXPos, (kFieldFirstLine + field) * lineHeight, label, LEFT_MODE);
+    }
+}
+
+void DisplayRenderer::drawField(Field field,
+                                const int32_t (&values)[NbrOfFields],
+                                bool useGlyphAtlas) {
+    // formatted without width or precision, not supported by minimal-printf
+    char text[kValueLength + 1];
+    if (field == Gear) {
+        snprintf(text, sizeof(text), "%" PRId32, values[Gear]);
+    } else {
+        const uint32_t magnitude =
+            static_cast<uint32_t>(values[field] < 0 ? -values[field] : values[field]);
+        snprintf(text,
+                 sizeof(text),
+                 "%s%" PRIu32 ".%c%c%s",
+                 values[field] < 0 ? "-" : "",
+                 magnitude / 100,
+                 static_cast<char>('0' + (magnitude / 10) % 10),
+                 static_cast<char>('0' + magnitude % 10),
+                 kFieldUnits[field]);
+    }
+
+    const sFONT* font   = UTIL_LCD_GetFont();
+    const uint32_t xPos = kFieldXPos + kLabelLength * font->Width;
+    const uint32_t yPos = (kFieldFirstLine + field) * font->Height;
+    if (useGlyphAtlas) {
+        GlyphAtlas::getInstance().drawText(xPos, yPos, text, kValueLength);
+        return;
+    }
+    // padded with spaces, which erase the end of a longer previous value
+    const size_t length = strlen(text);
+    memset(&text[length], ' ', kValueLength - length);
+    text[kValueLength] = '\0';
+    UTIL_LCD_DisplayStringAt(xPos, yPos, reinterpret_cast<uint8_t*>(text), LEFT_MODE);
+}
+
+}  // namespace multi_tasking
@@ -0,0 +1,109 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file display_renderer.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Display rendering on a dedicated low priority thread, fed through a
+ *        latest-value mailbox (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+#include "speed_history.hpp"
+#include "speed_sparkline.hpp"
+
+namespace multi_tasking {
+
+// values shown on the display
+struct DisplaySnapshot {
+    uint8_t gear;
+    float speed;
+    float distance;
+    float temperature;
+};
+
+class DisplayRenderer {
+   public:
+    explicit DisplayRenderer(
+        const bike_computer::SpeedHistory& speedHistory);  // NOLINT(runtime/references)
+
+    // make the class non copyable
+    DisplayRenderer(DisplayRenderer&)            = delete;
+    DisplayRenderer& operator=(DisplayRenderer&) = delete;
+
+    // start the render thread, the display device must be initialized
+    void start();
+
+    // stop the render thread once the frame being drawn is shown
+    void stop();
+
+    // replace the snapshot to render (a snapshot not rendered yet is dropped),
+    // never blocks
+    void publish(const DisplaySnapshot& snapshot);
+
+    // number of snapshots replaced before being rendered
+    uint32_t getDroppedCount() const;
+
+   private:
+    void render();
+
+    // values are drawn with 2 decimals (minimal-printf configuration), a field
+    // is redrawn only when its value at that resolution changes
+    static int32_t quantize(float value);
+
+    enum Field : uint8_t { Gear = 0, Speed, Distance, Temperature, NbrOfFields };
+
+    // the labels are drawn once. The values are composed from the pre-rendered
+    // glyphs of the atlas, or drawn by the lcd utilities at the same place when
+    // the atlas is not built.
+    void drawLabels();
+    void drawField(Field field, const int32_t (&values)[NbrOfFields], bool useGlyphAtlas);
+
+    // a frame is composed in the back buffer, which is first brought up to date
+    // with the shown frame (the fields and the graph are drawn incrementally).
+    // beginFrame() returns false if the frame must be drawn in the shown buffer.
+    bool beginFrame();
+    // the back buffer is shown from the next vertical blanking
+    void endFrame();
+
+    static constexpr uint32_t kNewSnapshotFlag = (1UL << 0);
+    static constexpr uint32_t kStopFlag        = (1UL << 1);
+
+    SpeedSparkline _speedSparkline;
+    Thread _thread;
+    EventFlags _eventFlags;
+
+    // latest-value mailbox, protected by a (short) critical section
+    DisplaySnapshot _snapshot = {};
+    bool _hasNewSnapshot      = false;
+    uint32_t _droppedCount    = 0;
+
+    // frame buffers of the lcd layer (in SDRAM), the back one is composed while
+    // the lcd controller reads the other one
+    uint32_t _frameBuffers[2] = {};
+    uint8_t _backBuffer       = 1;
+    bool _isDoubleBuffered    = false;
+
+    // values currently on the display, only accessed by the render thread
+    int32_t _renderedValues[NbrOfFields] = {};
+    bool _hasRenderedValues              = false;
+};
+
+}  // namespace multi_tasking
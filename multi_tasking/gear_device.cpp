@@ -37,8 +37,15 @@
 
 namespace multi_tasking {
 
-GearDevice::GearDevice(EventQueue& eventQueue, mbed::Callback<void(uint8_t, uint8_t)> cb)
-    : _eventQueue(eventQueue), _cb(cb){
+GearDevice::GearDevice(EventQueue& eventQueue,
+                       mbed::Callback<void(uint8_t, uint8_t)> cb,
+                       bike_computer::EventQueueMonitor* eventQueueMonitor,
+                       bike_computer::InputRecorder* inputRecorder)
+    : _eventQueue(eventQueue),
+      _cb(cb),
+      _eventQueueMonitor(eventQueueMonitor),
+      _inputRecorder(inputRecorder) {
+    setCassette(bike_computer::Drivetrain::getDefaultProfile());
 
     // register the joystick event handler
     disco::Joystick::getInstance().setUpCallback(
@@ -48,13 +55,20 @@ GearDevice::GearDevice(EventQueue& eventQueue, mbed::Callback<void(uint8_t, uint
 }
 
 void GearDevice::onJoystickUp() {
-    if (core_util_atomic_load_u8(&_currentGear) < bike_computer::kMaxGear) {
+    if (_inputRecorder != nullptr) {
+        _inputRecorder->record(bike_computer::InputEvent::JoystickUp);
+    }
+    if (core_util_atomic_load_u8(&_currentGear) <
+        core_util_atomic_load_u8(&_nbrOfGears)) {
         core_util_atomic_incr_u8(&_currentGear, 1);
         postEvent();
     }
 }
 
 void GearDevice::onJoystickDown() {
+    if (_inputRecorder != nullptr) {
+        _inputRecorder->record(bike_computer::InputEvent::JoystickDown);
+    }
     if (core_util_atomic_load_u8(&_currentGear) > bike_computer::kMinGear) {
         core_util_atomic_decr_u8(&_currentGear, 1);
         postEvent();
@@ -65,11 +79,48 @@ uint8_t GearDevice::getCurrentGear() {
     return core_util_atomic_load_u8(&_currentGear); }
 
 uint8_t GearDevice::getCurrentGearSize() const {
-    return bike_computer::kMaxGearSize - core_util_atomic_load_u8(&_currentGear);
+    core_util_critical_section_enter();
+    const uint8_t gearSize = _cassette[_currentGear - bike_computer::kMinGear];
+    core_util_critical_section_exit();
+    return gearSize;
+}
+
+void GearDevice::setCassette(const bike_computer::DrivetrainProfile& profile) {
+    core_util_critical_section_enter();
+    for (uint8_t cog = 0; cog < bike_computer::kMaxCogs; cog++) {
+        _cassette[cog] = cog < profile.nbrOfCogs ? profile.cassette[cog] : 0;
+    }
+    _nbrOfGears = profile.nbrOfCogs;
+    if (_currentGear > _nbrOfGears) {
+        _currentGear = _nbrOfGears;
+    }
+    core_util_critical_section_exit();
+}
+
+void GearDevice::restoreGear(uint8_t gear) {
+    const uint8_t nbrOfGears = core_util_atomic_load_u8(&_nbrOfGears);
+    if (gear < bike_computer::kMinGear) {
+        gear = bike_computer::kMinGear;
+    } else if (gear > nbrOfGears) {
+        gear = nbrOfGears;
+    }
+    core_util_atomic_store_u8(&_currentGear, gear);
+    postEvent();
+}
+
+void GearDevice::injectInput(bike_computer::InputEvent inputEvent) {
+    if (inputEvent == bike_computer::InputEvent::JoystickUp) {
+        onJoystickUp();
+    } else if (inputEvent == bike_computer::InputEvent::JoystickDown) {
+        onJoystickDown();
+    }
 }
 
 void GearDevice::postEvent() {
     Event<void(uint8_t, uint8_t)> event(&_eventQueue, _cb);
-    event.post(getCurrentGear(), getCurrentGearSize());
+    int id = event.post(getCurrentGear(), getCurrentGearSize());
+    if (_eventQueueMonitor != nullptr) {
+        _eventQueueMonitor->recordPost(id != 0);
+    }
 }
 }  // namespace static_scheduling_with_event
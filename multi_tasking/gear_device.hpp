@@ -26,13 +26,19 @@
 
 #include "InterruptIn.h"
 #include "constants.hpp"
+#include "drivetrain.hpp"
+#include "heap_monitor.hpp"
+#include "input_recorder.hpp"
 #include "mbed.h"
 
 namespace multi_tasking {
 
 class GearDevice {
    public:
-    GearDevice(EventQueue& eventQueue, mbed::Callback<void(uint8_t, uint8_t)> cb);  // NOLINT(runtime/references)
+    GearDevice(EventQueue& eventQueue,  // NOLINT(runtime/references)
+               mbed::Callback<void(uint8_t, uint8_t)> cb,
+               bike_computer::EventQueueMonitor* eventQueueMonitor = nullptr,
+               bike_computer::InputRecorder* inputRecorder         = nullptr);
 
     // make the class non copyable
     GearDevice(GearDevice&)            = delete;
@@ -42,6 +48,16 @@ class GearDevice {
     uint8_t getCurrentGear();
     uint8_t getCurrentGearSize() const;
 
+    // cog sizes of the drivetrain, from the first gear: the current gear is
+    // limited to the number of cogs and the gear size is the one of its cog
+    void setCassette(const bike_computer::DrivetrainProfile& profile);
+
+    // gear restored after a restart, reported as a gear change
+    void restoreGear(uint8_t gear);
+
+    // replayed joystick up or down input, handled as the joystick input
+    void injectInput(bike_computer::InputEvent inputEvent);
+
    private:
     void postEvent();
 
@@ -58,11 +74,18 @@ class GearDevice {
 
     // data members
     uint8_t _currentGear = bike_computer::kMinGear;
+    uint8_t _nbrOfGears  = bike_computer::kMaxGear;
+    // read in ISR context, written in a critical section
+    uint8_t _cassette[bike_computer::kMaxCogs] = {};
 
     // Eventqueue
     EventQueue& _eventQueue;
     // Callbacks
     mbed::Callback<void(uint8_t, uint8_t)> _cb;
+    // used for reporting posts to the event queue (optional)
+    bike_computer::EventQueueMonitor* _eventQueueMonitor;
+    // records the joystick inputs (optional)
+    bike_computer::InputRecorder* _inputRecorder;
 
 };
 
@@ -0,0 +1,130 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file glyph_atlas.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Pre-rendered glyphs implementation (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#include "glyph_atlas.hpp"
+
+#include <cstring>
+
+// from disco_h747i (STM32 BSP and lcd utilities)
+#include "stm32_lcd.h"
+#include "stm32h747i_discovery_lcd.h"
+
+namespace multi_tasking {
+
+// layer used by the display device
+static constexpr uint32_t kLcdLayer = 0;
+
+static const char kGlyphs[] = "0123456789.- km/hC";
+static_assert(sizeof(kGlyphs) - 1 == 18, "One glyph is rendered per character");
+
+GlyphAtlas& GlyphAtlas::getInstance() {
+    static GlyphAtlas glyphAtlas;
+    return glyphAtlas;
+}
+
+bool GlyphAtlas::build() {
+    // the glyphs are copied as raw pixels into the frame buffer
+    if (hlcd_ltdc.LayerCfg[kLcdLayer].PixelFormat != LTDC_PIXEL_FORMAT_ARGB8888) {
+        return false;
+    }
+    const sFONT* font = UTIL_LCD_GetFont();
+    if (font == nullptr || font->Width > kMaxGlyphWidth ||
+        font->Height > kMaxGlyphHeight) {
+        return false;
+    }
+    const uint32_t textColor   = UTIL_LCD_GetTextColor();
+    const uint32_t backColor   = UTIL_LCD_GetBackColor();
+    const uint16_t bytesPerRow = (font->Width + 7) / 8;
+
+    memset(_glyphIndex, kNoGlyph, sizeof(_glyphIndex));
+    for (uint8_t glyph = 0; glyph < kNbrOfGlyphs; glyph++) {
+        const uint8_t character = static_cast<uint8_t>(kGlyphs[glyph]);
+        _glyphIndex[character]  = glyph;
+        // the font tables start at ' ', each row of a character is stored on
+        // bytesPerRow bytes, most significant bit first (as drawn by UTIL_LCD)
+        const uint8_t* bitmap =
+            &font->table[(character - ' ') * font->Height * bytesPerRow];
+        for (uint16_t row = 0; row < font->Height; row++) {
+            for (uint16_t column = 0; column < font->Width; column++) {
+                const uint8_t bits = bitmap[row * bytesPerRow + column / 8];
+                const bool isSet   = (bits & (0x80 >> (column % 8))) != 0;
+                _pixels[glyph][row * font->Width + column] =
+                    isSet ? textColor : backColor;
+            }
+        }
+    }
+    _glyphWidth  = font->Width;
+    _glyphHeight = font->Height;
+    _isBuilt     = true;
+    return true;
+}
+
+bool GlyphAtlas::isBuilt() const { return _isBuilt; }
+
+void GlyphAtlas::drawText(uint32_t xPos,
+                          uint32_t yPos,
+                          const char* text,
+                          uint8_t length) const {
+    if (!_isBuilt) {
+        return;
+    }
+    if (length > kMaxTextLength) {
+        length = kMaxTextLength;
+    }
+    uint8_t glyphs[kMaxTextLength];
+    bool isTextEnd = false;
+    for (uint8_t index = 0; index < length; index++) {
+        isTextEnd               = isTextEnd || text[index] == '\0';
+        const uint8_t character = isTextEnd ? ' ' : static_cast<uint8_t>(text[index]);
+        const uint8_t glyph =
+            character < sizeof(_glyphIndex) ? _glyphIndex[character] : kNoGlyph;
+        glyphs[index] = glyph == kNoGlyph ? _glyphIndex[' '] : glyph;
+    }
+
+    uint32_t* frameBuffer =
+        reinterpret_cast<uint32_t*>(hlcd_ltdc.LayerCfg[kLcdLayer].FBStartAdress);
+    const uint32_t lineWidth = hlcd_ltdc.LayerCfg[kLcdLayer].ImageWidth;
+    const int32_t rowSize =
+        static_cast<int32_t>(length * _glyphWidth * sizeof(uint32_t));
+    for (uint16_t row = 0; row < _glyphHeight; row++) {
+        uint32_t* line = frameBuffer + (yPos + row) * lineWidth + xPos;
+        // cached copies of the row may predate a DMA2D fill, they are dropped before
+        // the row is partially written and the row is written back for the lcd
+        // controller
+        SCB_CleanInvalidateDCache_by_Addr(line, rowSize);
+        for (uint8_t index = 0; index < length; index++) {
+            memcpy(line + index * _glyphWidth,
+                   &_pixels[glyphs[index]][row * _glyphWidth],
+                   _glyphWidth * sizeof(uint32_t));
+        }
+        SCB_CleanDCache_by_Addr(line, rowSize);
+    }
+}
+
+uint16_t GlyphAtlas::getGlyphWidth() const { return _glyphWidth; }
+
+uint16_t GlyphAtlas::getGlyphHeight() const { return _glyphHeight; }
+
+}  // namespace multi_tasking
@@ -0,0 +1,78 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file glyph_atlas.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Pre-rendered glyphs of the numeric display fields (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+
+#pragma once
+
+#include "mbed.h"
+
+namespace multi_tasking {
+
+// the digits, the decimal point, the sign and the unit characters of the numeric
+// fields are rendered once with the lcd font and colors, a field is then drawn by
+// copying the glyph rows into the frame buffer
+class GlyphAtlas {
+   public:
+    // the atlas is too large for the stack of the thread owning the bike system
+    static GlyphAtlas& getInstance();
+
+    // make the class non copyable
+    GlyphAtlas(GlyphAtlas&)            = delete;
+    GlyphAtlas& operator=(GlyphAtlas&) = delete;
+
+    // render the glyphs with the current lcd font and colors, must be called once
+    // the display device is initialized, returns false if the font is too large or
+    // if the frame buffer is not ARGB8888
+    bool build();
+    bool isBuilt() const;
+
+    // draw length characters at (xPos, yPos): a text shorter than length is padded
+    // with spaces and characters missing from the atlas are drawn as spaces
+    void drawText(uint32_t xPos, uint32_t yPos, const char* text, uint8_t length) const;
+
+    uint16_t getGlyphWidth() const;
+    uint16_t getGlyphHeight() const;
+
+    // longest text drawn at once
+    static constexpr uint8_t kMaxTextLength = 16;
+
+   private:
+    GlyphAtlas() = default;
+
+    static constexpr uint8_t kNbrOfGlyphs = 18;
+    // the largest font of the BSP (Font24)
+    static constexpr uint16_t kMaxGlyphWidth  = 17;
+    static constexpr uint16_t kMaxGlyphHeight = 24;
+    static constexpr uint8_t kNoGlyph         = 0xFF;
+
+    // ARGB8888, the format of the frame buffer
+    uint32_t _pixels[kNbrOfGlyphs][kMaxGlyphWidth * kMaxGlyphHeight] = {};
+    // glyph of each ASCII character
+    uint8_t _glyphIndex[128] = {};
+    uint16_t _glyphWidth     = 0;
+    uint16_t _glyphHeight    = 0;
+    bool _isBuilt            = false;
+};
+
+}  // namespace multi_tasking
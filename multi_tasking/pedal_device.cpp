@@ -37,8 +37,13 @@
 namespace multi_tasking {
 
 PedalDevice::PedalDevice(EventQueue& eventQueue, 
-    mbed::Callback<void(const std::chrono::milliseconds&)> cb)
-    : _eventQueue(eventQueue), _cb(cb) {
+    mbed::Callback<void(const std::chrono::milliseconds&)> cb,
+    bike_computer::EventQueueMonitor* eventQueueMonitor,
+    bike_computer::InputRecorder* inputRecorder)
+    : _eventQueue(eventQueue),
+      _cb(cb),
+      _eventQueueMonitor(eventQueueMonitor),
+      _inputRecorder(inputRecorder) {
     // register the joystick event handler
     disco::Joystick::getInstance().setLeftCallback(
         mbed::callback(this, &PedalDevice::onJoystickLeft));
@@ -53,6 +58,20 @@ std::chrono::milliseconds PedalDevice::getCurrentRotationTime() {
                bike_computer::kDeltaPedalRotationTime;
 }
 
+void PedalDevice::restoreRotationTime(const std::chrono::milliseconds& rotationTime) {
+    uint32_t step = 0;
+    if (rotationTime > bike_computer::kMinPedalRotationTime) {
+        step = static_cast<uint32_t>(
+            (rotationTime - bike_computer::kMinPedalRotationTime) /
+            bike_computer::kDeltaPedalRotationTime);
+    }
+    if (step > kNbSteps) {
+        step = kNbSteps;
+    }
+    core_util_atomic_store_u32(&_currentStep, step);
+    postEvent();
+}
+
 void PedalDevice::increaseRotationSpeed() {
     if (core_util_atomic_load_u32(&_currentStep) > 0) {
         core_util_atomic_decr_u32(&_currentStep, 1);
@@ -67,13 +86,34 @@ void PedalDevice::decreaseRotationSpeed() {
     }
 }
 
-void PedalDevice::onJoystickLeft() { decreaseRotationSpeed(); }
+void PedalDevice::onJoystickLeft() {
+    if (_inputRecorder != nullptr) {
+        _inputRecorder->record(bike_computer::InputEvent::JoystickLeft);
+    }
+    decreaseRotationSpeed();
+}
 
-void PedalDevice::onJoystickRight() { increaseRotationSpeed(); }
+void PedalDevice::onJoystickRight() {
+    if (_inputRecorder != nullptr) {
+        _inputRecorder->record(bike_computer::InputEvent::JoystickRight);
+    }
+    increaseRotationSpeed();
+}
+
+void PedalDevice::injectInput(bike_computer::InputEvent inputEvent) {
+    if (inputEvent == bike_computer::InputEvent::JoystickLeft) {
+        onJoystickLeft();
+    } else if (inputEvent == bike_computer::InputEvent::JoystickRight) {
+        onJoystickRight();
+    }
+}
 
 void PedalDevice::postEvent() {
     Event<void(const std::chrono::milliseconds&)> event(&_eventQueue, _cb);
-    event.post(getCurrentRotationTime());
+    int id = event.post(getCurrentRotationTime());
+    if (_eventQueueMonitor != nullptr) {
+        _eventQueueMonitor->recordPost(id != 0);
+    }
 }
 
 }  // namespace static_scheduling_with_event
@@ -25,6 +25,8 @@
 #pragma once
 
 #include "constants.hpp"
+#include "heap_monitor.hpp"
+#include "input_recorder.hpp"
 #include "mbed.h"
 
 namespace multi_tasking {
@@ -32,7 +34,9 @@ namespace multi_tasking {
 class PedalDevice {
    public:
     PedalDevice(EventQueue& eventQueue, 
-    mbed::Callback<void(const std::chrono::milliseconds&)> cb);
+    mbed::Callback<void(const std::chrono::milliseconds&)> cb,
+    bike_computer::EventQueueMonitor* eventQueueMonitor = nullptr,
+    bike_computer::InputRecorder* inputRecorder = nullptr);
     
     // make the class non copyable
     PedalDevice(PedalDevice&)            = delete;
@@ -41,6 +45,12 @@ class PedalDevice {
     // method called for updating the bike system
     std::chrono::milliseconds getCurrentRotationTime();
 
+    // rotation time restored after a restart, reported as a rotation change
+    void restoreRotationTime(const std::chrono::milliseconds& rotationTime);
+
+    // replayed joystick left or right input, handled as the joystick input
+    void injectInput(bike_computer::InputEvent inputEvent);
+
    private:
     void onJoystickLeft();
     void onJoystickRight();
@@ -54,6 +64,10 @@ class PedalDevice {
     
     // Callbacks
     mbed::Callback<void(const std::chrono::milliseconds&)> _cb;
+    // used for reporting posts to the event queue (optional)
+    bike_computer::EventQueueMonitor* _eventQueueMonitor;
+    // records the joystick inputs (optional)
+    bike_computer::InputRecorder* _inputRecorder;
 
     volatile uint32_t _currentStep = static_cast<uint32_t>(
         (bike_computer::kInitialPedalRotationTime - bike_computer::kMinPedalRotationTime)
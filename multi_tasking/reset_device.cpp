@@ -40,8 +40,31 @@ static constexpr uint8_t kPolarityPressed = 1;
 
 namespace multi_tasking {
 
-ResetDevice::ResetDevice(mbed::Callback<void()> cb) : _resetButton(PUSH_BUTTON) {
-    _resetButton.fall(cb);
+ResetDevice::ResetDevice(mbed::Callback<void()> cb, mbed::Callback<void()> longPressCb)
+    : _resetButton(PUSH_BUTTON), _cb(cb), _longPressCb(longPressCb) {
+    _pressTimer.start();
+    // the button is pressed on the rising edge (kPolarityPressed)
+    _resetButton.rise(callback(this, &ResetDevice::onPressed));
+    _resetButton.fall(callback(this, &ResetDevice::onReleased));
+}
+
+void ResetDevice::onPressed() {
+    _pressTime = _pressTimer.elapsed_time();
+    _isPressed = true;
+}
+
+void ResetDevice::onReleased() {
+    if (!_isPressed) {
+        return;
+    }
+    _isPressed = false;
+    const std::chrono::microseconds pressDuration =
+        _pressTimer.elapsed_time() - _pressTime;
+    if (_longPressCb && pressDuration >= kLongPressDuration) {
+        _longPressCb();
+    } else {
+        _cb();
+    }
 }
 
 }  // namespace static_scheduling_with_event
@@ -30,17 +30,33 @@ namespace multi_tasking {
 
 class ResetDevice {
    public:
+    // cb is called when the button is released after a short press, longPressCb
+    // (if any) when it is released after kLongPressDuration or more
     explicit ResetDevice(
-        mbed::Callback<void()> cb);  // constructeur -- NOLINT(runtime/references)
+        mbed::Callback<void()> cb,  // constructeur -- NOLINT(runtime/references)
+        mbed::Callback<void()> longPressCb = nullptr);
 
     // make the class non copyable
     ResetDevice(ResetDevice&)            = delete;
     ResetDevice& operator=(ResetDevice&) = delete;
 
+    static constexpr std::chrono::milliseconds kLongPressDuration = 2000ms;
+
    private:
+    // called in ISR context
+    void onPressed();
+    void onReleased();
+
     // data members
     // instance representing the reset button
     InterruptIn _resetButton;
+    mbed::Callback<void()> _cb;
+    mbed::Callback<void()> _longPressCb;
+    Timer _pressTimer;
+    std::chrono::microseconds _pressTime = std::chrono::microseconds::zero();
+    // a release is only handled after a press (not when the button is held at
+    // construction or after a bounce)
+    bool _isPressed = false;
 };
 
 }  // namespace static_scheduling_with_event
@@ -0,0 +1,137 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file speed_sparkline.cpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Rolling speed graph implementation (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#include "speed_sparkline.hpp"
+
+#include <cstring>
+
+// from disco_h747i (STM32 BSP)
+#include "stm32h747i_discovery_lcd.h"
+
+namespace multi_tasking {
+
+// layer used by the display device
+static constexpr uint32_t kLcdInstance = 0;
+static constexpr uint32_t kLcdLayer    = 0;
+
+SpeedSparkline::SpeedSparkline(const bike_computer::SpeedHistory& speedHistory)
+    : _speedHistory(speedHistory) {}
+
+void SpeedSparkline::render() {
+    // the number of resets is read first: a reset applied in between is then
+    // seen on the next call
+    const uint32_t nbrOfResets = _speedHistory.getNbrOfResets();
+    const uint32_t count       = _speedHistory.getCount();
+    if (!_hasRendered || nbrOfResets != _renderedNbrOfResets || count < _renderedCount ||
+        count - _renderedCount > kNbrOfColumns) {
+        _renderedNbrOfResets = nbrOfResets;
+        redraw(count);
+        return;
+    }
+
+    const uint32_t nbrOfNewSamples = count - _renderedCount;
+    if (nbrOfNewSamples == 0) {
+        return;
+    }
+    // the graph is scrolled in place as raw ARGB8888 pixels, it is drawn again by
+    // the BSP with other pixel formats
+    if (hlcd_ltdc.LayerCfg[kLcdLayer].PixelFormat != LTDC_PIXEL_FORMAT_ARGB8888) {
+        redraw(count);
+        return;
+    }
+
+    // move the existing pixels and only draw the newest columns
+    scrollLeft(nbrOfNewSamples);
+    for (uint32_t sampleIndex = _renderedCount; sampleIndex < count; sampleIndex++) {
+        drawColumn(kNbrOfColumns - (count - sampleIndex),
+                   _speedHistory.getSample(sampleIndex));
+    }
+    _renderedCount = count;
+}
+
+void SpeedSparkline::redraw(uint32_t count) {
+    BSP_LCD_FillRect(kLcdInstance,
+                     kXPos,
+                     kYPos,
+                     kNbrOfColumns * kColumnWidth,
+                     kHeight,
+                     kBackgroundColor);
+    const uint32_t nbrOfSamples = count < kNbrOfColumns ? count : kNbrOfColumns;
+    for (uint32_t sampleIndex = count - nbrOfSamples; sampleIndex < count;
+         sampleIndex++) {
+        drawColumn(kNbrOfColumns - (count - sampleIndex),
+                   _speedHistory.getSample(sampleIndex));
+    }
+    _renderedCount = count;
+    _hasRendered   = true;
+}
+
+void SpeedSparkline::scrollLeft(uint32_t nbrOfColumns) {
+    if (nbrOfColumns >= kNbrOfColumns) {
+        return;
+    }
+    // the frame buffer is ARGB8888, move each row of the graph area in place
+    uint32_t* frameBuffer =
+        reinterpret_cast<uint32_t*>(hlcd_ltdc.LayerCfg[kLcdLayer].FBStartAdress);
+    const uint32_t lineWidth = hlcd_ltdc.LayerCfg[kLcdLayer].ImageWidth;
+    const uint32_t shift     = nbrOfColumns * kColumnWidth;
+    const uint32_t width     = kNbrOfColumns * kColumnWidth;
+    const int32_t rowSize    = static_cast<int32_t>(width * sizeof(uint32_t));
+    for (uint32_t row = 0; row < kHeight; row++) {
+        uint32_t* line = frameBuffer + (kYPos + row) * lineWidth + kXPos;
+        // the columns were drawn by DMA2D (BSP_LCD_FillRect), cached copies of the
+        // row are dropped before it is read
+        SCB_CleanInvalidateDCache_by_Addr(line, rowSize);
+        memmove(line, line + shift, (width - shift) * sizeof(uint32_t));
+        // the lcd controller reads the frame buffer from memory, not from the cache
+        SCB_CleanDCache_by_Addr(line, rowSize);
+    }
+}
+
+void SpeedSparkline::drawColumn(uint32_t column, float speed) {
+    float ratio = speed / kMaxGraphSpeed;
+    if (ratio > 1.0f) {
+        ratio = 1.0f;
+    }
+    const uint32_t barHeight = static_cast<uint32_t>(ratio * kHeight);
+    const uint32_t xPos      = kXPos + column * kColumnWidth;
+    if (barHeight < kHeight) {
+        BSP_LCD_FillRect(kLcdInstance,
+                         xPos,
+                         kYPos,
+                         kColumnWidth,
+                         kHeight - barHeight,
+                         kBackgroundColor);
+    }
+    if (barHeight > 0) {
+        BSP_LCD_FillRect(kLcdInstance,
+                         xPos,
+                         kYPos + kHeight - barHeight,
+                         kColumnWidth,
+                         barHeight,
+                         kGraphColor);
+    }
+}
+
+}  // namespace multi_tasking
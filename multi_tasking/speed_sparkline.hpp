@@ -0,0 +1,68 @@
+// Copyright 2022 Haute école d'ingénierie et d'architecture de Fribourg
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/****************************************************************************
+ * @file speed_sparkline.hpp
+ * @author Amez-Droz Jonathan, Loup Olivia
+ *
+ * @brief Rolling speed graph, rendered incrementally (multi-tasking)
+ *
+ * @date 2026-10-18
+ * @version 1.0.0
+ ***************************************************************************/
+
+#pragma once
+
+#include "mbed.h"
+#include "speed_history.hpp"
+
+namespace multi_tasking {
+
+class SpeedSparkline {
+   public:
+    explicit SpeedSparkline(
+        const bike_computer::SpeedHistory& speedHistory);  // NOLINT(runtime/references)
+
+    // make the class non copyable
+    SpeedSparkline(SpeedSparkline&)            = delete;
+    SpeedSparkline& operator=(SpeedSparkline&) = delete;
+
+    // draw the samples pushed since the last call: the graph is shifted left
+    // and only the new columns are drawn (the whole graph is drawn on the
+    // first call, after a history reset or when too many samples are missed)
+    void render();
+
+   private:
+    void redraw(uint32_t count);
+    void scrollLeft(uint32_t nbrOfColumns);
+    void drawColumn(uint32_t column, float speed);
+
+    // graph area (bottom of the 800x480 lcd)
+    static constexpr uint32_t kXPos        = 20;
+    static constexpr uint32_t kYPos        = 400;
+    static constexpr uint32_t kColumnWidth = 2;
+    static constexpr uint32_t kNbrOfColumns =
+        bike_computer::SpeedHistory::kCapacity;  // one column per sample
+    static constexpr uint32_t kHeight       = 64;
+    static constexpr float kMaxGraphSpeed   = 64.0f;  // km / h at the top of the graph
+    static constexpr uint32_t kGraphColor   = 0xFF0000FF;
+    static constexpr uint32_t kBackgroundColor = 0xFFFFFFFF;
+
+    const bike_computer::SpeedHistory& _speedHistory;
+    uint32_t _renderedCount       = 0;
+    uint32_t _renderedNbrOfResets = 0;
+    bool _hasRendered             = false;
+};
+
+}  // namespace multi_tasking
@@ -27,6 +27,7 @@
 #include <chrono>
 
 #include "advdembsof_library/utils/cpu_logger.hpp"
+#include "bike_system_stats.hpp"
 #include "gear_device.hpp"
 #include "mbed_trace.h"
 #include "rtos.h"
@@ -170,11 +171,19 @@ void BikeSystem::startWithEventQueue() {
     printStatsEvent.post();
 #endif
 
-    eventQueue.dispatch_forever();
+    while (!core_util_atomic_load_bool(&_stopFlag)) {
+        eventQueue.dispatch_for(kMajorCycleDuration);
+    }
 }
 
 void BikeSystem::stop() { core_util_atomic_store_bool(&_stopFlag, true); }
 
+void BikeSystem::onReset() { _resetDevice.simulatePress(); }
+
+void BikeSystem::printStatistics() {
+    bike_computer::printBikeSystemStats(_cpuLogger, _taskLogger, _resetLatencyStats);
+}
+
 #if defined(MBED_TEST_MODE)
 // cppcheck-suppress [unusedFunction, unmatchedSuppression]
 const advembsof::TaskLogger& BikeSystem::getTaskLogger() { return _taskLogger; }
@@ -184,20 +193,29 @@ void BikeSystem::init() {
     // start the timer
     _timer.start();
 
-    // initialize the lcd display
+    // the display and the sensor are independent, they are initialized
+    // concurrently
+    bike_computer::InitGraph initGraph;
+    initGraph.addJob("Display", callback(this, &BikeSystem::initDisplay));
+    initGraph.addJob("Sensor", callback(this, &BikeSystem::initSensor));
+    initGraph.run();
+
+    // enable/disable task logging
+    _taskLogger.enable(true);
+}
+
+void BikeSystem::initDisplay() {
     disco::ReturnCode rc = _displayDevice.init();
     if (rc != disco::ReturnCode::Ok) {
         tr_error("Failed to initialized the lcd display: %d", static_cast<int>(rc));
     }
+}
 
-    // initialize the sensor device
+void BikeSystem::initSensor() {
     bool present = _sensorDevice.init();
     if (!present) {
         tr_error("Sensor not present or initialization failed");
     }
-
-    // enable/disable task logging
-    _taskLogger.enable(true);
 }
 
 void BikeSystem::gearTask() {
@@ -207,6 +225,8 @@ void BikeSystem::gearTask() {
     // no need to protect access to data members (single threaded)
     _currentGear     = _gearDevice.getCurrentGear();
     _currentGearSize = _gearDevice.getCurrentGearSize();
+    bike_computer::DataBus::getInstance().getGearTopic().publish(
+        {_currentGear, _currentGearSize});
 
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kGearTaskIndex, taskStartTime);
@@ -222,6 +242,8 @@ void BikeSystem::speedDistanceTask() {
     // no need to protect access to data members (single threaded)
     _currentSpeed     = _speedometer.getCurrentSpeed();
     _traveledDistance = _speedometer.getDistance();
+    bike_computer::DataBus::getInstance().getSpeedTopic().publish(_currentSpeed);
+    bike_computer::DataBus::getInstance().getDistanceTopic().publish(_traveledDistance);
 
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kSpeedTaskIndex, taskStartTime);
@@ -232,6 +254,8 @@ void BikeSystem::temperatureTask() {
 
     // no need to protect access to data members (single threaded)
     _currentTemperature = _sensorDevice.readTemperature();
+    bike_computer::DataBus::getInstance().getTemperatureTopic().publish(
+        _currentTemperature);
 
     // simulate task computation by waiting for the required task computation time
     /*
@@ -257,6 +281,7 @@ void BikeSystem::resetTask() {
         std::chrono::microseconds responseTime =
             _timer.elapsed_time() - _resetDevice.getPressTime();
         tr_info("Reset task: response time is %" PRIu64 " usecs", responseTime.count());
+        _resetLatencyStats.record(responseTime);
         _speedometer.reset();
     }
 
@@ -270,6 +295,7 @@ void BikeSystem::displayTask1() {
     _displayDevice.displayGear(_currentGear);
     _displayDevice.displaySpeed(_currentSpeed);
     _displayDevice.displayDistance(_traveledDistance);
+    bike_computer::StartupTimeline::getInstance().markFirstFrame();
 
     // simulate task computation by waiting for the required task computation time
     /*
@@ -30,8 +30,12 @@
 #include "task_logger.hpp"
 
 // from common
+#include "data_bus.hpp"
+#include "init_graph.hpp"
+#include "latency_stats.hpp"
 #include "sensor_device.hpp"
 #include "speedometer.hpp"
+#include "startup_timeline.hpp"
 
 // local
 #include "gear_device.hpp"
@@ -59,6 +63,12 @@ class BikeSystem {
     // cppcheck-suppress [unusedFunction, unmatchedSuppression]
     void stop();
 
+    // press the reset button from software (scripted input)
+    void onReset();
+
+    // cpu usage, task periods and computation times, reset response time
+    void printStatistics();
+
 #if defined(MBED_TEST_MODE)
     // cppcheck-suppress [unusedFunction, unmatchedSuppression]
     const advembsof::TaskLogger& getTaskLogger();
@@ -67,6 +77,9 @@ class BikeSystem {
    private:
     // private methods
     void init();
+    // init jobs
+    void initDisplay();
+    void initSensor();
     void gearTask();
     void speedDistanceTask();
     void temperatureTask();
@@ -101,6 +114,9 @@ class BikeSystem {
 
     // used for logging cpu usage
     advembsof::CPULogger _cpuLogger;
+
+    // measured in resetTask
+    bike_computer::LatencyStats _resetLatencyStats;
 };
 
 }  // namespace static_scheduling
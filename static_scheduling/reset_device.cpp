@@ -52,7 +52,7 @@ ResetDevice::ResetDevice(Timer& timer) : _resetButton(PUSH_BUTTON), _timer(timer
 bool ResetDevice::checkReset() {
     std::chrono::microseconds initialTime = _timer.elapsed_time();
     std::chrono::microseconds elapsedTime = std::chrono::microseconds::zero();
-    bool resetDetect                      = false;
+    bool resetDetect = core_util_atomic_exchange_bool(&_simulatedPress, false);
 
     while (elapsedTime < kTaskRunTime) {
         if (_resetButton.read() == kPolarityPressed) {
@@ -67,4 +67,9 @@ void ResetDevice::onRise() { _pressTime = _timer.elapsed_time(); }
 
 std::chrono::microseconds ResetDevice::getPressTime() { return _pressTime; }
 
+void ResetDevice::simulatePress() {
+    onRise();
+    core_util_atomic_store_bool(&_simulatedPress, true);
+}
+
 }  // namespace static_scheduling
@@ -42,6 +42,9 @@ class ResetDevice {
     // for computing the response time
     std::chrono::microseconds getPressTime();
 
+    // press the button from software (scripted input)
+    void simulatePress();
+
    private:
     // called when the button is pressed
     void onRise();
@@ -51,6 +54,7 @@ class ResetDevice {
     InterruptIn _resetButton;
     Timer& _timer;
     std::chrono::microseconds _pressTime;
+    volatile bool _simulatedPress = false;
 };
 
 }  // namespace static_scheduling
@@ -26,6 +26,7 @@
 
 #include <chrono>
 
+#include "bike_system_stats.hpp"
 #include "gear_device.hpp"
 #include "mbed_trace.h"
 #if MBED_CONF_MBED_TRACE_ENABLE
@@ -53,6 +54,8 @@ static constexpr std::chrono::milliseconds kDisplayTask2Period               = 1
 static constexpr std::chrono::milliseconds kDisplayTask2Delay                = 1200ms;
 static constexpr std::chrono::milliseconds kDisplayTask2ComputationTime      = 100ms;
 static constexpr std::chrono::milliseconds kMajorCycleDuration               = 1600ms;
+static constexpr std::chrono::milliseconds kTimerWheelTickPeriod(
+    MBED_CONF_APP_TIMER_WHEEL_TICK_PERIOD);
 
 BikeSystem::BikeSystem()
     : _timer(),
@@ -63,7 +66,9 @@ BikeSystem::BikeSystem()
       _speedometer(_timer),
       _sensorDevice(),
       _taskLogger(),
-      _cpuLogger(_timer) {}
+      _cpuLogger(_timer) {
+    _traceChannel = bike_computer::BinaryTrace::getInstance().getChannel("EventThread");
+}
 
 void BikeSystem::start() {
     tr_info("Starting Super-Loop with event handling");
@@ -72,64 +77,60 @@ void BikeSystem::start() {
 
     EventQueue eventQueue;  // create the event queue
 
-    auto startTime = _timer.elapsed_time();
-
-    // Schedule the gearEvent task
-    Event<void()> gearEvent(
-        &eventQueue,
-        callback(this, &BikeSystem::gearTask));  // Create the event with callback on the
-                                                 // wanted function
-    gearEvent.delay(kGearTaskDelay);    // define the delay between two calls of the task
-    gearEvent.period(kGearTaskPeriod);  // define the period
-    gearEvent.post();                   // schedule the task to the event queue
-    // Schedule the speedDistance task
-    Event<void()> speedDistanceEvent(&eventQueue,
-                                     callback(this, &BikeSystem::speedDistanceTask));
-    speedDistanceEvent.delay(kSpeedDistanceTaskDelay);
-    speedDistanceEvent.period(kSpeedDistanceTaskPeriod);
-    speedDistanceEvent.post();
-
-    // Schedule the temperatureTask
-    Event<void()> temperatureTaskEvent(&eventQueue,
-                                       callback(this, &BikeSystem::temperatureTask));
-    temperatureTaskEvent.delay(kTemperatureTaskDelay);
-    temperatureTaskEvent.period(kTemperatureTaskPeriod);
-    temperatureTaskEvent.post();
-
-    // Schedule the resetTask
-    Event<void()> resetTaskEvent(&eventQueue, callback(this, &BikeSystem::resetTask));
-    resetTaskEvent.delay(kResetTaskDelay);
-    resetTaskEvent.period(kResetTaskPeriod);
-    resetTaskEvent.post();
-
-    // Schedule the displayTask1
-    Event<void()> displayTask1Event(&eventQueue,
-                                    callback(this, &BikeSystem::displayTask1));
-    displayTask1Event.delay(kDisplayTask1Delay);
-    displayTask1Event.period(kDisplayTask1Period);
-    displayTask1Event.post();
-
-    // Schedule the displayTask2
-    Event<void()> displayTask2Event(&eventQueue,
-                                    callback(this, &BikeSystem::displayTask2));
-    displayTask2Event.delay(kDisplayTask2Delay);
-    displayTask2Event.period(kDisplayTask2Period);
-    displayTask2Event.post();
+    // all periodic tasks are run by the timer wheel, a single periodic event is
+    // posted on the queue
+    bike_computer::TimerWheel timerWheel(eventQueue, kTimerWheelTickPeriod);
+    timerWheel.addTimer(
+        "Gear", callback(this, &BikeSystem::gearTask), kGearTaskPeriod, kGearTaskDelay);
+    timerWheel.addTimer("SpeedDistance",
+                        callback(this, &BikeSystem::speedDistanceTask),
+                        kSpeedDistanceTaskPeriod,
+                        kSpeedDistanceTaskDelay);
+    timerWheel.addTimer("Temperature",
+                        callback(this, &BikeSystem::temperatureTask),
+                        kTemperatureTaskPeriod,
+                        kTemperatureTaskDelay);
+    timerWheel.addTimer("Reset",
+                        callback(this, &BikeSystem::resetTask),
+                        kResetTaskPeriod,
+                        kResetTaskDelay);
+    timerWheel.addTimer("Display1",
+                        callback(this, &BikeSystem::displayTask1),
+                        kDisplayTask1Period,
+                        kDisplayTask1Delay);
+    timerWheel.addTimer("Display2",
+                        callback(this, &BikeSystem::displayTask2),
+                        kDisplayTask2Period,
+                        kDisplayTask2Delay);
     tr_info("All tasks posted");
 
 #if !MBED_TEST_MODE
-    Event<void()> printStatsEvent(
-        &eventQueue, callback(&_cpuLogger, &advembsof::CPULogger::printStats));
-    printStatsEvent.delay(kMajorCycleDuration);
-    printStatsEvent.period(kMajorCycleDuration);
-    printStatsEvent.post();
+    timerWheel.addTimer("CPULogger",
+                        callback(&_cpuLogger, &advembsof::CPULogger::printStats),
+                        kMajorCycleDuration,
+                        kMajorCycleDuration);
+    timerWheel.addTimer("TimerWheelStats",
+                        callback(&timerWheel, &bike_computer::TimerWheel::printStats),
+                        kMajorCycleDuration,
+                        kMajorCycleDuration);
 #endif
 
-    eventQueue.dispatch_forever();
+    if (!timerWheel.start()) {
+        tr_error("Cannot post the timer wheel tick event");
+    }
+
+    while (!core_util_atomic_load_bool(&_stopFlag)) {
+        eventQueue.dispatch_for(kMajorCycleDuration);
+    }
+    timerWheel.stop();
 }
 
 void BikeSystem::stop() { core_util_atomic_store_bool(&_stopFlag, true); }
 
+void BikeSystem::printStatistics() {
+    bike_computer::printBikeSystemStats(_cpuLogger, _taskLogger, _resetLatencyStats);
+}
+
 #if defined(MBED_TEST_MODE)
 const advembsof::TaskLogger& BikeSystem::getTaskLogger() { return _taskLogger; }
 #endif  // defined(MBED_TEST_MODE)
@@ -138,20 +139,32 @@ void BikeSystem::init() {
     // start the timer
     _timer.start();
 
-    // initialize the lcd display
+    // the display and the sensor are independent, they are initialized
+    // concurrently
+    bike_computer::InitGraph initGraph;
+    initGraph.addJob("Display", callback(this, &BikeSystem::initDisplay));
+    initGraph.addJob("Sensor", callback(this, &BikeSystem::initSensor));
+    initGraph.run();
+
+    // enable/disable task logging
+    _taskLogger.enable(true);
+
+    // traces are formatted and printed by a low priority thread
+    bike_computer::BinaryTrace::getInstance().start();
+}
+
+void BikeSystem::initDisplay() {
     disco::ReturnCode rc = _displayDevice.init();
     if (rc != disco::ReturnCode::Ok) {
         tr_error("Failed to initialized the lcd display: %d", static_cast<int>(rc));
     }
+}
 
-    // initialize the sensor device
+void BikeSystem::initSensor() {
     bool present = _sensorDevice.init();
     if (!present) {
         tr_error("Sensor not present or initialization failed");
     }
-
-    // enable/disable task logging
-    _taskLogger.enable(true);
 }
 
 void BikeSystem::gearTask() {
@@ -161,6 +174,8 @@ void BikeSystem::gearTask() {
     // no need to protect access to data members (single threaded)
     _currentGear     = _gearDevice.getCurrentGear();
     _currentGearSize = _gearDevice.getCurrentGearSize();
+    bike_computer::DataBus::getInstance().getGearTopic().publish(
+        {_currentGear, _currentGearSize});
 
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kGearTaskIndex, taskStartTime);
@@ -176,6 +191,8 @@ void BikeSystem::speedDistanceTask() {
     // no need to protect access to data members (single threaded)
     _currentSpeed     = _speedometer.getCurrentSpeed();
     _traveledDistance = _speedometer.getDistance();
+    bike_computer::DataBus::getInstance().getSpeedTopic().publish(_currentSpeed);
+    bike_computer::DataBus::getInstance().getDistanceTopic().publish(_traveledDistance);
 
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kSpeedTaskIndex, taskStartTime);
@@ -186,6 +203,8 @@ void BikeSystem::temperatureTask() {
 
     // no need to protect access to data members (single threaded)
     _currentTemperature = _sensorDevice.readTemperature();
+    bike_computer::DataBus::getInstance().getTemperatureTopic().publish(
+        _currentTemperature);
 
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kTemperatureTaskIndex, taskStartTime);
@@ -200,8 +219,12 @@ void BikeSystem::resetTask() {
     auto taskStartTime = _timer.elapsed_time();
 
     if (core_util_atomic_load_bool(&_resetFlag)) {
-        tr_info("Reset task: response time is %" PRIu64 " usecs",
-                (_timer.elapsed_time() - _resetTime).count());
+        const std::chrono::microseconds responseTime = _timer.elapsed_time() - _resetTime;
+        _resetLatencyStats.record(responseTime);
+        if (_traceChannel != nullptr) {
+            _traceChannel->write(bike_computer::TraceFormat::ResetResponseTime,
+                                 static_cast<uint32_t>(responseTime.count()));
+        }
 
         core_util_atomic_store_bool(&_resetFlag, false);
         _speedometer.reset();
@@ -217,6 +240,7 @@ void BikeSystem::displayTask1() {
     _displayDevice.displayGear(_currentGear);
     _displayDevice.displaySpeed(_currentSpeed);
     _displayDevice.displayDistance(_traveledDistance);
+    bike_computer::StartupTimeline::getInstance().markFirstFrame();
 
     _taskLogger.logPeriodAndExecutionTime(
         _timer, advembsof::TaskLogger::kDisplayTask1Index, taskStartTime);
@@ -31,8 +31,14 @@
 #include "task_logger.hpp"
 
 // from common
+#include "binary_trace.hpp"
+#include "data_bus.hpp"
+#include "init_graph.hpp"
+#include "latency_stats.hpp"
 #include "sensor_device.hpp"
 #include "speedometer.hpp"
+#include "startup_timeline.hpp"
+#include "timer_wheel.hpp"
 
 // local
 #include "gear_device.hpp"
@@ -56,6 +62,12 @@ class BikeSystem {
     // method called for stopping the system
     void stop();
 
+    // called when the reset button is pressed, or from software (scripted input)
+    void onReset();
+
+    // cpu usage, task periods and computation times, reset response time
+    void printStatistics();
+
 #if defined(MBED_TEST_MODE)
     const advembsof::TaskLogger& getTaskLogger();
 #endif  // defined(MBED_TEST_MODE)
@@ -63,6 +75,9 @@ class BikeSystem {
    private:
     // private methods
     void init();
+    // init jobs
+    void initDisplay();
+    void initSensor();
     void gearTask();
     void speedDistanceTask();
     void temperatureTask();
@@ -70,8 +85,6 @@ class BikeSystem {
     void displayTask1();
     void displayTask2();
 
-    void onReset();
-
     // stop flag, used for stopping the super-loop (set in stop())
     bool _stopFlag = false;
     // timer instance used for loggint task time and used by ResetDevice
@@ -104,6 +117,11 @@ class BikeSystem {
     // used to register the occurence of the reset
     std::chrono::microseconds _resetTime = std::chrono::microseconds::zero();
     volatile bool _resetFlag             = false;
+    // measured in resetTask
+    bike_computer::LatencyStats _resetLatencyStats;
+
+    // deferred trace channel
+    bike_computer::TraceChannel* _traceChannel = nullptr;
 };
 
 }  // namespace static_scheduling_with_event